@@ -1,999 +1,2569 @@
-/**
- * @file pixy2.cpp
- * @brief file containing the pixy2 class programs, compatible with mbed-os 6 (baremetal or multithread) using UART interface with non blocking functions
- * @author Hugues Angelis - Théo Le Paih - Wael Hazami
- * @date March 2022
- */
- 
-#include "pixy2.h"
-
-int sommeDeControle,sommeRecue;
-
-PIXY2::PIXY2(PinName tx, PinName rx, int debit) : Pixy2_numBlocks(0), Pixy2_numVectors(0), Pixy2_numIntersections(0), Pixy2_numBarcodes(0)
-{   
-    _Pixy2 = new UnbufferedSerial (tx, rx, debit);
-    _Pixy2->attach (callback(this,&PIXY2::pixy2_getByte));
-    etat = idle;
-    Pixy2_buffer = (Byte*) malloc (0x100); 
-}
-
-PIXY2::~PIXY2()
-{
-    free (Pixy2_buffer);
-}
-
-// POUR DEBUG //
-PIXY2::T_Pixy2State PIXY2::getEtat()
-{
-    return this->etat;
-}
-
-void PIXY2::affDataSize()
-{
-    printf("dataSize : %d\n\r", this->dataSize);
-}
-// Pour détail d'une trame (a mettre dans la fct correspondante) :
-//pc.printf("pixSync : %d, pixType : %d, pixLength : %d, pixChecksum : %d\n\r", msg->pixSync, msg->pixType, msg->pixLength, msg->pixChecksum);
-
-/* Le programme utilise l'interruption de la liaison série pour recevoir le message et avancer la machine d'état pour permettre au programme de ne pas être bloquant en réception.
-   Lorsqu'on appelle une fonction, elle retourne le code -2 pour signifier que le message de réponse de la caméra n'est pas completement reçu...
-   Les étapes de fonctionnement sont les suivantes :
-   
-   * idle : La caméra n'a pas été solicité => on peut envoyer le message de requête.
-   * messageSent : La requête a été transmise, mais la réponse n'est pas encore arrivée.
-   * receivingHeader : Le mot de synchro a été reçu, le reste de l'entête est en cours de réception.
-   * receivingData : L'entête a été intégralement reçu (et traité) et on est en train de recevoir la payload.
-   * dataReceived : La réponse a été intégralement reçue et est disponible pour le traitement (et la libération).
-   
-   On utilise plusieurs pointeurs : 
-   * wPointer est le pointeur d'écriture des octets reçus dans le buffer de réception
-   * hPointer est le pointeur de l'entête du message
-   * dPointer est le pointeur de la zone de données
-   
-   On rajoute une variable : dataSize, qui définit la quantité de données à recevoir (issue de l'entête)
-   
-   **** COMMENT CA MARCHE ****
-   
-   Au début wPointer = 0. Quand wPointer est supérieur à 1 (donc qu'on a reçu au moins 2 octets), on regarde si on a reçu le code de début de trame 0xC1AF
-   Si ce n'est pas le cas, on continue de recevoir les octets et on les stock jusqu'à trouver le code de début de trame.
-   Quand on trouve le code, on enregistre le point de départ (c'est hPointer) comme étant la position actuelle du wPointer-1.
-   A partir de ça, on attend de recevoir les 6 premiers octets de l'entête :
-   * start of frame (hPointer et hPointer + 1)
-   * identification du type (hPointer + 2)
-   * taille des données (hPointer + 3)
-   Et ensuite si on a une trame avec un checksum (normal) :
-   * le checksum (hPointer + 4 et hPointer + 5)
-   * les données (hPointer + 6 et suivant)
-   Et si on a une trame sans checksum (pas normal) :
-   * les données (hPointer + 4 et suivant)
-   
-   On continue alors de recevoir des octets jusqu'à ce que wPointer soit égal à dPointer + dataSize - 1
-   par exemple si la data fait 4 octets et une trame avec checksum, on reçoit tant que wPointer est inférieur à 9 (6 + 4 - 1)
-   ou pour la même quantité de données mais avec une trame sans checksum 7 (4 + 4 - 1)...
-   
-                                          Automate des fonctions.
-
-         appel de la fonction    
-   /---        publique      ---\ /-------------------- géré par l'interruption -------------------\
-
-    |------|  envoi   |---------|  start  |-----------|  header  |-----------|  trame  |----------|
-    |      |  ordre   |         |  reçu   | receiving |   reçu   | receiving |  reçue  |   data   |
-    | Idle |----+---->| msgSent |----+--->|   header  |----+---->|    data   |----+--->| received |---\
-    |      |          |         |   C1AF  |           |    6o    |           | (data   |          |   |
-    |------|          |---------|(ou C1AE)|-----------|          |-----------|  size)  |----------|   |
-       |                                                                                              |
-       \-------------------<---------------------------+---------------------------<------------------/
-                                          lecture des données reçues
-                                                         
-       \-------------------------------  appel de la fonction publique  ------------------------------/
-
-    Pour l'utilisateur seul l'appel de la fonction publique est nécessaire.
-    Tant qu'il récupère un code de retour -1, cela signifie que la tâche n'est pas achevée
-    Quand le code reçu est 0, cela signifie que le résultat est disponible
-    Toutes les autres valeurs signifient une erreur
-*/
-
-void PIXY2::pixy2_getByte ()    // Interruption de la pixy2
-{
-    T_Word                  *buffer;
-    
-    _Pixy2->read(&Pixy2_buffer[wPointer],1);                                        // On stocke l'octet reçu dans la première case dispo du buffer de réception
-    
-    
-    switch (etat) {
-        case messageSent :                                                          // Si on a envoyé une requete => on attend un entête
-            if (wPointer > 0) {                                                     // On attend d'avoir reçu 2 octets
-                buffer = (T_Word*) &Pixy2_buffer[wPointer-1];                       // On pointe la structure sur les 2 derniers octets reçus
-                if ((buffer->mot == PIXY2_CSSYNC) || (buffer->mot == PIXY2_SYNC)) { // Si c'est un mot d'entête
-                    etat = receivingHeader;                                         // On passe à l'état réception de l'entête
-                    hPointer = wPointer - 1;                                        // On initialise le pointeur de l'entête
-                    if (buffer->mot == PIXY2_SYNC) {
-                        frameContainChecksum = 0;                                   // Si c'est un entête sans checksum, on mémorise qu'il n'y a pas de checksum à vérifier
-                        dPointer = hPointer + PIXY2_NCSHEADERSIZE;
-                    } else {
-                        frameContainChecksum = 1;                                   // Sinon, on mémorise qu'il y a un checksum à vérifier
-                        dPointer = hPointer + PIXY2_CSHEADERSIZE;
-                    }
-                }                                                                   // Si on n'a pas de mot d'entête on attend d'en trouver un...
-            }
-            break;
-
-        case receivingHeader :                                                      // Si on est en train de recevoir un entête (entre le SYNC et... La fin de l'entête)
-            if ((frameContainChecksum && ((wPointer - hPointer) == (PIXY2_CSHEADERSIZE - 1))) || (!frameContainChecksum && ((wPointer - hPointer) == (PIXY2_NCSHEADERSIZE - 1)))) {
-                                                                                    // Si on a reçu 6 octets pour une trame avec checksum ou 4 pour une trame sans checksum, c'est à dire un entête complet
-                etat = receivingData;                                               // On dit que l'on va de recevoir des données
-                dataSize = Pixy2_buffer[hPointer + 3];                              // On enregistre la taille de la payload
-                if (dataSize == 0)                                                  // Si on ne doit recevoir qu'un entête, on a terminé
-                    etat = idle;                                                    // On revient à l'état d'attente d'ordre
-            }    
-            break;
-
-        case receivingData :                                                        // Si on est en train de recevoir des données.
-            if (wPointer == ((dataSize - 1) + dPointer)) {                          // Quand on a reçu toutes les données
-                etat = dataReceived;                                                // On dit que c'est OK pour leur traitement         
-            }
-            break;
-
-        default : // On ne traite volontairement ici pas tous les cas, en particulier idle et dataReceived. C'est à la fonction de le faire ! Le reste est lié à des réceptions de données.
-            break;
-    }
-    wPointer++;                                                                     // on pointe la case suivante du buffer de réception
-
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetVersion (void){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 0;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_ASK_VERS;
-    msg.frame.header.pixLength = dataSize;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetResolution (void){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 1;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_ASK_RESOL;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = 0;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetCameraBrightness (Byte brightness){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 1;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_BRIGHT;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = brightness;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetServo (Word s0, Word s1){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 4;
-    T_Word              tmp;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_SERVOS;
-    msg.frame.header.pixLength = dataSize;
-    tmp.mot = s0;
-    msg.frame.data[0] = tmp.octet[0];
-    msg.frame.data[1] = tmp.octet[1];
-    tmp.mot = s1;
-    msg.frame.data[2] = tmp.octet[0];
-    msg.frame.data[3] = tmp.octet[1];
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetLED (Byte red, Byte green, Byte blue){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 3;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_LED;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = red;
-    msg.frame.data[1] = green;
-    msg.frame.data[2] = blue;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetLamp (Byte upper, Byte lower){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 2;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_LAMP;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = upper;
-    msg.frame.data[1] = lower;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetFPS (void){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 0;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_ASK_FPS;
-    msg.frame.header.pixLength = dataSize;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetBlocks (Byte sigmap, Byte maxBloc){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 2;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_ASK_BLOC;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = sigmap;
-    msg.frame.data[1] = maxBloc;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetLineFeature (Byte type, Byte feature){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 2;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_ASK_LINE;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = type;
-    msg.frame.data[1] = feature;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetMode (Byte mode){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 1;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_MODE;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = mode;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetNextTurn (Word angle){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 2;
-    T_Word              tmp;
-    tmp.mot = angle;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_TURN;
-    msg.frame.header.pixLength = dataSize;
-    tmp.mot = angle;
-    msg.frame.data[0] = tmp.octet[0];
-    msg.frame.data[1] = tmp.octet[1];
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetDefaultTurn (Word angle){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 2;
-    T_Word              tmp;
-    tmp.mot = angle;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_DEFTURN;
-    msg.frame.header.pixLength = dataSize;
-    tmp.mot = angle;
-    msg.frame.data[0] = tmp.octet[0];
-    msg.frame.data[1] = tmp.octet[1];
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetVector (Byte vectorIndex){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 1;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_VECTOR;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = vectorIndex;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndReverseVector (void){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 0;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_SET_REVERSE;
-    msg.frame.header.pixLength = dataSize;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetRGB (Word x, Word y, Byte saturate){
-    T_pixy2SendBuffer   msg;
-    int                 i = 0, dataSize = 5;
-    msg.frame.header.pixSync = PIXY2_SYNC;
-    msg.frame.header.pixType = PIXY2_ASK_VIDEO;
-    msg.frame.header.pixLength = dataSize;
-    msg.frame.data[0] = x;
-    msg.frame.data[1] = y;
-    msg.frame.data[2] = saturate;
-    do {
-        while(!_Pixy2->writable());
-        _Pixy2->write(&msg.data[i],1);
-        i++;
-    } while (i<(PIXY2_NCSHEADERSIZE+dataSize));
-    return PIXY2_OK;
-}
-
-/*  La fonction est bloquante à l'envoi (pas vraiment le choix), mais elle est non bloquante en réception. On essayera de faire une fonction non bloquante en envoi avec write, mais c'est pas la priorité.
-Le principe c'est de stocker dans un buffer circulaire les données au fur et à mesure qu'elle sont reçues et de traiter uniquement en castant les infos. Pour cela, il faut recevoir et stocker. */
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getVersion (T_pixy2Version **ptrVersion){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetVersion();                                      // On envoie la trame de demande de la version
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if (msg->pixType == PIXY2_REP_VERS) {                                   // On vérifie que la trame est du type convenable (REPONSE VERSION)
-                *ptrVersion =   (T_pixy2Version*) &Pixy2_buffer[dPointer];          // On mappe le pointeur de structure sur le buffer de réception.         
-            } else {                                                                // Si ce n'est pas le bon type
-                if (msg->pixType == PIXY2_REP_ERROR) {                              // Cela pourrait être une trame d'erreur
-                    cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];              // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-                } else cr = PIXY2_TYPE_ERROR;                                       // Si le type ne correspond à rien de normal on signale une erreur de type.
-            }
-            etat = idle;                                                            // On annonce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getResolution (T_pixy2Resolution **ptrResolution){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetResolution();                                   // On envoie la trame de demande de la résolution
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if (msg->pixType == PIXY2_REP_RESOL) {                                  // On vérifie que la trame est du type convenable (REPONSE RESOLUTION)
-                *ptrResolution = (T_pixy2Resolution*) &Pixy2_buffer[dPointer];      // On mappe le pointeur de structure sur le buffer de réception.
-            } else {                                                                // Si ce n'est pas le bon type
-                if (msg->pixType == PIXY2_REP_ERROR) {                              // Cela pourrait être une trame d'erreur
-                    cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];              // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-                } else cr = PIXY2_TYPE_ERROR;                                       // Si le type ne correspond à rien de normal on signale une erreur de type.
-            }
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setCameraBrightness (Byte brightness){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetCameraBrightness (brightness);                  // On envoie la trame de règlage de la luminosité
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setServos (Word s0, Word s1){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetServo (s0, s1);                                 // On envoie la trame de règlage des servos moteurs
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setLED (Byte red, Byte green, Byte blue){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetLED (red, green, blue);                         // On envoie la trame de règlage des composantes de la LED RGB
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setLamp (Byte upper, Byte lower){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetLamp (upper, lower);                            // On envoie la trame de règlage d'allumage des lumières de contraste
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getFPS (T_pixy2ReturnCode **framerate){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetFPS();                                          // On envoie la trame de demande du Framerate
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if (msg->pixType == PIXY2_REP_FPS) {                                    // On vérifie que la trame est du type convenable (REPONSE FPS)
-                *framerate = (T_pixy2ReturnCode*) &Pixy2_buffer[dPointer];           // On mappe le pointeur de structure sur le buffer de réception.
-            } else {                                                                // Si ce n'est pas le bon type
-                if (msg->pixType == PIXY2_REP_ERROR) {                              // Cela pourrait être une trame d'erreur
-                    cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];              // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-                } else cr = PIXY2_TYPE_ERROR;                                       // Si le type ne correspond à rien de normal on signale une erreur de type.
-            }
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getBlocks (Byte sigmap, Byte maxBloc){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetBlocks(sigmap, maxBloc);                        // On envoie la trame de demande de blocs de couleur
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if (msg->pixType == PIXY2_REP_BLOC) {                                   // On vérifie que la trame est du type convenable (REPONSE BLOCS)
-                Pixy2_blocks = (T_pixy2Bloc*) &Pixy2_buffer[dPointer];              // On mappe le pointeur de structure sur le buffer de réception.
-                Pixy2_numBlocks = dataSize / sizeof(T_pixy2Bloc);                   // On indique le nombre de blocs reçus
-            } else {                                                                // Si ce n'est pas le bon type
-                if (msg->pixType == PIXY2_REP_ERROR) {                              // Cela pourrait être une trame d'erreur
-                    cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];              // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-                } else cr = PIXY2_TYPE_ERROR;                                       // Si le type ne correspond à rien de normal on signale une erreur de type.
-            }
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getFeatures (){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    T_pixy2LineFeature* lineFeature;
-    int                 fPointer;                                                   // Pointeur sur une feature entière
-    int                 fdPointer;                                                  // Pointeur sur un élément à l'intérieur d'une feature
-
-    if (frameContainChecksum) {                                                     // Si la trame contient un checksum
-        if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {                // On lance la validation du checksum
-            return PIXY2_BAD_CHECKSUM;                                              // Si le checksum est faux on retourne une erreur
-        }
-    }
-    if (msg->pixType == PIXY2_REP_LINE) {                                       // On vérifie que la trame est du type convenable (REPONSE LIGNE)
-        fPointer = dPointer;                                                        // On pointe sur la premiere feature
-        do {
-            lineFeature = (T_pixy2LineFeature*) &Pixy2_buffer[fPointer];            // On mappe le pointeur de structure sur le buffer de réception des features.
-            if (lineFeature->fType == PIXY2_VECTOR) {                               // On regarde si le type est vecteur
-                Pixy2_numVectors = lineFeature->fLength / sizeof(T_pixy2Vector);    // Si oui, on compte combien il y a de vecteurs
-                fdPointer = fPointer + 2;                                           // On pointe sur le premier élément de la feature
-                Pixy2_vectors = (T_pixy2Vector*) &Pixy2_buffer[fdPointer];          // On mappe le résultat
-                fPointer += lineFeature->fLength + 2;                               // On déplace le pointeur de données et on recommence
-                cr |= PIXY2_VECTOR;
-            }
-            if (lineFeature->fType == PIXY2_INTERSECTION) {                         // On regarde si le type est intersection
-                Pixy2_numIntersections = lineFeature->fLength / sizeof(T_pixy2Intersection);
-                                                                                    // Si oui, on compte combien il y a d'intersections
-                fdPointer = fPointer + 2;                                           // On pointe sur le premier élément de la feature                                                                    
-                Pixy2_intersections = (T_pixy2Intersection*) &Pixy2_buffer[fdPointer];
-                                                                                    // On mappe le résultat sur l'entête de l'intersection
-                fPointer += lineFeature->fLength + 2;                               // On déplace le pointeur de données et on recommence
-                cr |= PIXY2_INTERSECTION;
-            }
-            if (lineFeature->fType == PIXY2_BARCODE) {                              // On regarde si le type est codebarre
-                Pixy2_numBarcodes = lineFeature->fLength / sizeof(T_pixy2BarCode);
-                                                                                    // Si oui, on compte combien il y a de codebarre
-                fdPointer = fPointer + 2;                                           // On pointe sur le premier élément de la feature
-                Pixy2_barcodes = (T_pixy2BarCode*) &Pixy2_buffer[fdPointer];        // On mappe le résultat
-                fPointer += lineFeature->fLength + 2;                               // On déplace le pointeur de données et on recommence
-                cr |= PIXY2_BARCODE;
-            }
-        } while(fPointer < ((dataSize - 1) + dPointer));                            // Tant qu'il y a des données à traiter
-    } else {                                                                        // Si ce n'est pas le bon type
-        if (msg->pixType == PIXY2_REP_ERROR) {                                      // Cela pourrait être une trame d'erreur ou quand on ne reçoit rien
-            cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                      // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-        } else cr = PIXY2_TYPE_ERROR;                                               // Si le type ne correspond à rien de normal on signale une erreur de type.
-    }
-    etat = idle;                                                                    // On annoce que la pixy est libre
-    return cr;
-}
-
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getMainFeature (Byte features){
-
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetLineFeature(0, features);                      // On envoie la trame de demande de suivi de ligne
-            if (cr!= PIXY2_OK) return cr;                                          // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                    // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            cr = PIXY2::pixy2_getFeatures();                                        // On appelle la fonction de traitement.
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getAllFeature (Byte features){
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetLineFeature(1, features);                       // On envoie la trame de demande de suivi de ligne
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            cr = PIXY2::pixy2_getFeatures();                                        // On appelle la fonction de traitement.
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setMode (Byte mode)
-{
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetMode (mode);                                    // On envoie la trame de règlage du mode de fonctionnement du suivi de ligne
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setNextTurn (sWord angle)
-{
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetNextTurn (angle);                               // On envoie la trame de choix de l'angle du prochain virage
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setDefaultTurn (sWord angle)
-{
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetDefaultTurn (angle);                            // On envoie la trame de choix de l'angle par défaut des virages
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setVector (Byte vectorIndex)
-{
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndSetVector (vectorIndex);                           // On envoie la trame de choix du vecteur à suivre
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_ReverseVector (void)
-{
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndReverseVector ();                                  // On envoie la trame d'inversion de l'image (haut en bas et bas en haut)
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-
-        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if ((msg->pixType == PIXY2_REP_ACK) || (msg->pixType == PIXY2_REP_ERROR)) {
-                                                                                    // On vérifie que la trame est du type convenable (ACK ou ERREUR)
-                cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];                  // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-            } else cr = PIXY2_TYPE_ERROR;                                           // Si le type ne correspond à rien de normal on signale une erreur de type.
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getRGB (Word x, Word y, Byte saturate, T_pixy2Pixel **pixel){
-
-    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
-    T_pixy2ErrorCode    cr = PIXY2_OK;
-    
-    switch (etat) {
-        case idle :                                                                 // Si la caméra est inactive
-            wPointer = 0;                                                           // On remonte en haut du buffer
-            cr = PIXY2::pixy2_sndGetRGB(x, y, saturate);                            // On envoie la trame de demande de la couleur (RGB) d'un carée de pixel
-            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
-            etat = messageSent;                                                     // On passe à l'attente du message de réponse
-            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
-            break;
-            
-        case dataReceived :                                                      // Quand on a reçu l'intégralité du message
-            if (frameContainChecksum) {                                             // Si la trame contient un checksum
-                if (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0) {        // On lance la validation du checksum
-                    return PIXY2_BAD_CHECKSUM;                                      // Si le checksum est faux on retourne une erreur
-                }
-            }
-            if (msg->pixType == PIXY2_REP_ACK) {                                    // On vérifie que la trame est du type convenable (REPONSE ACK)
-                *pixel = (T_pixy2Pixel*) &Pixy2_buffer[dPointer];                    // On mappe le pointeur de structure sur le buffer de réception.
-            } else {                                                                // Si ce n'est pas le bon type
-                if (msg->pixType == PIXY2_REP_ERROR) {                              // Cela pourrait être une trame d'erreur
-                    cr = *(T_pixy2ErrorCode*) &Pixy2_buffer[dPointer];              // Si c'est le cas, on copie le code d'erreur reçu dans la variable de retour
-                } else cr = PIXY2_TYPE_ERROR;                                       // Si le type ne correspond à rien de normal on signale une erreur de type.
-            }
-            etat = idle;                                                            // On annoce que la pixy est libre
-            break;
-
-        default :                                                                   // Dans tous les autres cas
-            cr = PIXY2_BUSY;                                                        // On signale que la caméra est occupée.
-            break;
-    }
-    return cr;
-}
-
-
-
-PIXY2::T_pixy2ErrorCode PIXY2::pixy2_validateChecksum (Byte* tab){
-    Word    i, sum = 0;
-    T_Word  *tmp;
-    
-    for (i=0; i<*(tab+3);i++)   sum = sum + *(tab + PIXY2_CSHEADERSIZE + i);
-    tmp = (T_Word*) (tab+4);
-    
-    if (tmp->mot == sum) return PIXY2_OK;
-    else {
-        if (_DEBUG_) {
-            sommeDeControle = sum;
-            sommeRecue = tmp->mot;
-        }
-        return PIXY2_BAD_CHECKSUM;
-    }
-} 
+/**
+ * @file pixy2.cpp
+ * @brief file containing the pixy2 class programs, compatible with mbed-os 6 (baremetal or multithread) using UART interface with non blocking functions
+ * @author Hugues Angelis - Théo Le Paih - Wael Hazami
+ * @date March 2022
+ */
+ 
+#include "pixy2.h"
+
+int sommeDeControle,sommeRecue;
+
+#if PIXY2_LOG_LEVEL > PIXY2_LOG_OFF
+#define PIXY2_LOG(level, event, a0, a1, a2) do { if ((level) <= PIXY2_LOG_LEVEL) pixy2_log ((level), (event), (a0), (a1), (a2)); } while (0)
+#else
+#define PIXY2_LOG(level, event, a0, a1, a2) do { } while (0)
+#endif
+
+static const char * const pixy2_logFormat[PIXY2_EVT_NUMBER] = {                    // Textes des évènements (mise en forme différée, voir pixy2_formatLog)
+    "bad checksum (type %u, computed %u, received %u)",
+    "type error (type %u, length %u)",
+    "camera error (code %d, length %u)",
+    "blocks frame (%u blocks, %u merged, %u tracks)",
+    "line frame (features 0x%02X, length %u)",
+    "log measure (%u/%u)",
+    "timeout (request type %u)"
+};
+
+static const char pixy2_logLevel[] = "-EWID";                                       // Lettre de chaque niveau
+
+static const struct {                                                               // Fonctionnalités absentes des premiers builds d'une version du firmware
+    PIXY2::Byte     capability;
+    PIXY2::Byte     major;
+    PIXY2::Byte     minor;
+    PIXY2::Word     build;                                                          // Premier build de major.minor qui offre la fonctionnalité
+} pixy2_capVersion[] = {
+    {PIXY2_CAP_VIDEO, 3, 0, 11}                                                     // API vidéo (getRGB) : firmware 3.0.11 et suivants, https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
+};
+
+PIXY2::PIXY2(PinName tx, PinName rx, int debit) : Pixy2_numBlocks(0), Pixy2_numVectors(0), Pixy2_numIntersections(0), Pixy2_numBarcodes(0), Pixy2_numMergedBlocks(0), Pixy2_mergeTime(0), Pixy2_numClusters(0), Pixy2_clusterTime(0), Pixy2_numTracks(0), Pixy2_trackTime(0), Pixy2_trackWorstTime(0), Pixy2_groundTime(0), Pixy2_groundPoints(0), Pixy2_triggerState(0), Pixy2_logLost(0), Pixy2_recLost(0), Pixy2_coalesced(0), Pixy2_deferLost(0), Pixy2_trajectoryActive(0), Pixy2_statsAlert(0), Pixy2_numNormBlocks(0), Pixy2_capabilities(PIXY2_CAP_ALL), Pixy2_firstAnswerTime(0), Pixy2_firstFrameTime(0), Pixy2_allocations(0), Pixy2_allocatedBytes(0), mergeEnable(0), mergeTolerance(0), clusterEnable(0), clusterEps(1), clusterMinBlocs(1), trackEnable(0), trackGate(0), trackMaxMissed(0), trackNextId(1), lensEnable(0), heatEnable(0), trigVectors(0), lazyFeatures(0), featurePresent(0), featureDecoded(0), logHead(0), logTail(0), recEnable(0), recBuffer(NULL), recCurrent(0), coalesceWindow(0), coalesceValid(0), coalescePending(0), rxTime(0), pubFrames(NULL), pubLast(0), timeout(0), sendTime(0), deferFrames(NULL), deferHead(0), deferTail(0), trajNum(0), trajIndex(0), servoPeriod(20000), streamOwned(0), sigStats(NULL), resolutionValid(0), normBuffer(NULL), versionValid(0), errorBackoff(0), errorHold(0)
+{   
+    createTime = us_ticker_read();                                                  // Origine des mesures de démarrage
+    _Pixy2 = new UnbufferedSerial (tx, rx, debit);
+    Pixy2_allocations++;
+    Pixy2_allocatedBytes += sizeof (UnbufferedSerial);
+    _Pixy2->attach (callback(this,&PIXY2::pixy2_getByte));
+    etat = idle;
+    Pixy2_buffer = (Byte*) pixy2_alloc (0x100); 
+    homography[PIXY2_GRID_BLOCS].enable = 0;
+    homography[PIXY2_GRID_LINE].enable = 0;
+    for (int i = 0; i < PIXY2_MAX_TRIGGERS; i++) triggers[i].pixType = PIXY2_TRIG_NONE;
+    for (int i = 0; i < 8; i++) trigBySig[i] = 0;
+    for (int i = 0; i <= PIXY2_MAX_FILTER_STAGES; i++) Pixy2_filterCount[i] = 0;
+    recFull[0] = recFull[1] = 0;
+    memset (&linkStats, 0, sizeof (linkStats));
+    for (int i = 0; i < PIXY2_CLASSES; i++) buckets[i].rate = 0;                    // Pas de limitation de débit
+    memset (retryRules, 0, sizeof (retryRules));                                    // Pas de nouvel essai
+    memset (retryState, 0, sizeof (retryState));
+    core_util_atomic_flag_clear (&deferBusy);
+    servoPos[0] = servoPos[1] = 0xFFFF;                                             // Position des servos inconnue
+}
+
+PIXY2::~PIXY2()
+{
+    free (Pixy2_buffer);
+    free (recBuffer);
+    free (pubFrames);
+    free (deferFrames);
+    free (sigStats);
+    free (normBuffer);
+}
+
+// POUR DEBUG //
+PIXY2::T_Pixy2State PIXY2::getEtat()
+{
+    return this->etat;
+}
+
+void PIXY2::affDataSize()
+{
+    printf("dataSize : %d\n\r", this->dataSize);
+}
+// Pour détail d'une trame (a mettre dans la fct correspondante) :
+//pc.printf("pixSync : %d, pixType : %d, pixLength : %d, pixChecksum : %d\n\r", msg->pixSync, msg->pixType, msg->pixLength, msg->pixChecksum);
+
+/* Le programme utilise l'interruption de la liaison série pour recevoir le message et avancer la machine d'état pour permettre au programme de ne pas être bloquant en réception.
+   Lorsqu'on appelle une fonction, elle retourne le code -2 pour signifier que le message de réponse de la caméra n'est pas completement reçu...
+   Les étapes de fonctionnement sont les suivantes :
+   
+   * idle : La caméra n'a pas été solicité => on peut envoyer le message de requête.
+   * messageSent : La requête a été transmise, mais la réponse n'est pas encore arrivée.
+   * receivingHeader : Le mot de synchro a été reçu, le reste de l'entête est en cours de réception.
+   * receivingData : L'entête a été intégralement reçu (et traité) et on est en train de recevoir la payload.
+   * dataReceived : La réponse a été intégralement reçue et est disponible pour le traitement (et la libération).
+   
+   On utilise plusieurs pointeurs : 
+   * wPointer est le pointeur d'écriture des octets reçus dans le buffer de réception
+   * hPointer est le pointeur de l'entête du message
+   * dPointer est le pointeur de la zone de données
+   
+   On rajoute une variable : dataSize, qui définit la quantité de données à recevoir (issue de l'entête)
+   
+   **** COMMENT CA MARCHE ****
+   
+   Au début wPointer = 0. Quand wPointer est supérieur à 1 (donc qu'on a reçu au moins 2 octets), on regarde si on a reçu le code de début de trame 0xC1AF
+   Si ce n'est pas le cas, on continue de recevoir les octets et on les stock jusqu'à trouver le code de début de trame.
+   Quand on trouve le code, on enregistre le point de départ (c'est hPointer) comme étant la position actuelle du wPointer-1.
+   A partir de ça, on attend de recevoir les 6 premiers octets de l'entête :
+   * start of frame (hPointer et hPointer + 1)
+   * identification du type (hPointer + 2)
+   * taille des données (hPointer + 3)
+   Et ensuite si on a une trame avec un checksum (normal) :
+   * le checksum (hPointer + 4 et hPointer + 5)
+   * les données (hPointer + 6 et suivant)
+   Et si on a une trame sans checksum (pas normal) :
+   * les données (hPointer + 4 et suivant)
+   
+   On continue alors de recevoir des octets jusqu'à ce que wPointer soit égal à dPointer + dataSize - 1
+   par exemple si la data fait 4 octets et une trame avec checksum, on reçoit tant que wPointer est inférieur à 9 (6 + 4 - 1)
+   ou pour la même quantité de données mais avec une trame sans checksum 7 (4 + 4 - 1)...
+   
+                                          Automate des fonctions.
+
+         appel de la fonction    
+   /---        publique      ---\ /-------------------- géré par l'interruption -------------------\
+
+    |------|  envoi   |---------|  start  |-----------|  header  |-----------|  trame  |----------|
+    |      |  ordre   |         |  reçu   | receiving |   reçu   | receiving |  reçue  |   data   |
+    | Idle |----+---->| msgSent |----+--->|   header  |----+---->|    data   |----+--->| received |---\
+    |      |          |         |   C1AF  |           |    6o    |           | (data   |          |   |
+    |------|          |---------|(ou C1AE)|-----------|          |-----------|  size)  |----------|   |
+       |                                                                                              |
+       \-------------------<---------------------------+---------------------------<------------------/
+                                          lecture des données reçues
+                                                         
+       \-------------------------------  appel de la fonction publique  ------------------------------/
+
+    Pour l'utilisateur seul l'appel de la fonction publique est nécessaire.
+    Tant qu'il récupère un code de retour -1, cela signifie que la tâche n'est pas achevée
+    Quand le code reçu est 0, cela signifie que le résultat est disponible
+    Toutes les autres valeurs signifient une erreur
+*/
+
+void PIXY2::pixy2_getByte ()    // Interruption de la pixy2
+{
+    T_Word                  *buffer;
+    
+    do {
+        _Pixy2->read(&Pixy2_buffer[wPointer],1);                                    // On stocke l'octet reçu dans la première case dispo du buffer de réception
+        linkStats.pixBytes++;
+    
+        switch (etat) {
+            case messageSent :                                                      // Si on a envoyé une requete => on attend un entête
+                if (wPointer > 0) {                                                 // On attend d'avoir reçu 2 octets
+                    buffer = (T_Word*) &Pixy2_buffer[wPointer-1];                   // On pointe la structure sur les 2 derniers octets reçus
+                    if ((buffer->mot == PIXY2_CSSYNC) || (buffer->mot == PIXY2_SYNC)) { // Si c'est un mot d'entête
+                        etat = receivingHeader;                                     // On passe à l'état réception de l'entête
+                        hPointer = wPointer - 1;                                    // On initialise le pointeur de l'entête
+                        if (buffer->mot == PIXY2_SYNC) {
+                            frameContainChecksum = 0;                               // Si c'est un entête sans checksum, on mémorise qu'il n'y a pas de checksum à vérifier
+                            dPointer = hPointer + PIXY2_NCSHEADERSIZE;
+                        } else {
+                            frameContainChecksum = 1;                               // Sinon, on mémorise qu'il y a un checksum à vérifier
+                            dPointer = hPointer + PIXY2_CSHEADERSIZE;
+                        }
+                    }                                                               // Si on n'a pas de mot d'entête on attend d'en trouver un...
+                }
+                break;
+
+            case receivingHeader :                                                  // Si on est en train de recevoir un entête (entre le SYNC et... La fin de l'entête)
+                if ((frameContainChecksum && ((wPointer - hPointer) == (PIXY2_CSHEADERSIZE - 1))) || (!frameContainChecksum && ((wPointer - hPointer) == (PIXY2_NCSHEADERSIZE - 1)))) {
+                                                                                        // Si on a reçu 6 octets pour une trame avec checksum ou 4 pour une trame sans checksum, c'est à dire un entête complet
+                    etat = receivingData;                                           // On dit que l'on va de recevoir des données
+                    dataSize = Pixy2_buffer[hPointer + 3];                          // On enregistre la taille de la payload
+                    if (dataSize == 0)                                              // Si on ne doit recevoir qu'un entête, on a terminé
+                        etat = idle;                                                // On revient à l'état d'attente d'ordre
+                }    
+                break;
+
+            case receivingData :                                                    // Si on est en train de recevoir des données.
+                if (wPointer == ((dataSize - 1) + dPointer)) {                      // Quand on a reçu toutes les données
+                    rxTime = us_ticker_read();                                      // Date du dernier octet (mesure de latence)
+                    linkStats.pixAnswers++;
+                    linkStats.pixLatency = rxTime - sendTime;                       // Temps de réponse de la caméra (requête -> dernier octet)
+                    if (linkStats.pixLatency > linkStats.pixWorstLatency) linkStats.pixWorstLatency = linkStats.pixLatency;
+                    if (Pixy2_firstAnswerTime == 0) Pixy2_firstAnswerTime = (rxTime != createTime) ? rxTime - createTime : 1;   // Première réponse depuis la construction
+                    etat = dataReceived;                                            // On dit que c'est OK pour leur traitement         
+                }
+                break;
+
+            default : // On ne traite volontairement ici pas tous les cas, en particulier idle et dataReceived. C'est à la fonction de le faire ! Le reste est lié à des réceptions de données.
+                break;
+        }
+        wPointer++;                                                                 // on pointe la case suivante du buffer de réception
+    } while (_Pixy2->readable());                                                   // On vide la FIFO de réception en une seule interruption
+
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndFrame (T_pixy2SendBuffer *msg, int dataSize){
+    Byte                cmdClass = pixy2_commandClass (msg->frame.header.pixType);
+    T_pixy2RetryState   *retry = &retryState[pixy2_requestSlot (msg->frame.header.pixType)];
+
+    if (!(Pixy2_capabilities & pixy2_commandCapability (msg->frame.header.pixType))) return PIXY2_UNSUPPORTED;  // Inutile d'attendre le refus de la caméra
+    if (errorHold) {                                                                // La politique d'erreur a suspendu les requêtes
+        if ((lWord) (us_ticker_read() - errorHoldStart) < errorBackoff) return PIXY2_BUSY;
+        errorHold = 0;
+    }
+    if (!streamOwned) {                                                             // Les mises à jour de trajectoire sont hors politique de nouvel essai
+        if (retry->armed) {                                                         // Nouvel essai d'une requête qui a échoué (avec les paramètres de ce dernier appel)
+            if ((lWord) (us_ticker_read() - retry->time) < retry->delay) return PIXY2_BUSY;   // Attente de fin du délai
+            retry->armed = 0;
+            linkStats.pixRetries++;
+        } else retry->count = 0;                                                    // Nouvelle requête de ce type : l'historique des échecs est oublié
+    }
+    if (!pixy2_takeToken (cmdClass, PIXY2_NCSHEADERSIZE + dataSize)) {              // Classe de commande au-delà de son débit : la requête n'est pas envoyée
+        linkStats.pixThrottled[cmdClass]++;
+        return PIXY2_THROTTLED;
+    }
+    coalesceValid = 0;                                                              // Toute nouvelle requête périme les résultats partagés
+    linkStats.pixRequests++;
+    sendTime = us_ticker_read();                                                    // Départ du délai de réponse
+    coalescePending = ((lWord) msg->frame.header.pixType << 16) | ((dataSize > 0) ? msg->frame.data[0] << 8 : 0) | ((dataSize > 1) ? msg->frame.data[1] : 0);
+    if (_Pixy2->write(msg->data, PIXY2_NCSHEADERSIZE + dataSize) != PIXY2_NCSHEADERSIZE + dataSize) return PIXY2_MISC_ERROR;   // Toute la trame en un seul appel
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetVersion (void){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 0;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_ASK_VERS;
+    msg.frame.header.pixLength = dataSize;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetResolution (void){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 1;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_ASK_RESOL;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = 0;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetCameraBrightness (Byte brightness){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 1;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_BRIGHT;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = brightness;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetServo (Word s0, Word s1){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 4;
+    T_Word              tmp;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_SERVOS;
+    msg.frame.header.pixLength = dataSize;
+    tmp.mot = s0;
+    msg.frame.data[0] = tmp.octet[0];
+    msg.frame.data[1] = tmp.octet[1];
+    tmp.mot = s1;
+    msg.frame.data[2] = tmp.octet[0];
+    msg.frame.data[3] = tmp.octet[1];
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetLED (Byte red, Byte green, Byte blue){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 3;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_LED;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = red;
+    msg.frame.data[1] = green;
+    msg.frame.data[2] = blue;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetLamp (Byte upper, Byte lower){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 2;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_LAMP;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = upper;
+    msg.frame.data[1] = lower;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetFPS (void){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 0;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_ASK_FPS;
+    msg.frame.header.pixLength = dataSize;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetBlocks (Byte sigmap, Byte maxBloc){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 2;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_ASK_BLOC;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = sigmap;
+    msg.frame.data[1] = maxBloc;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetLineFeature (Byte type, Byte feature){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 2;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_ASK_LINE;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = type;
+    msg.frame.data[1] = feature;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetMode (Byte mode){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 1;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_MODE;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = mode;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetNextTurn (Word angle){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 2;
+    T_Word              tmp;
+    tmp.mot = angle;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_TURN;
+    msg.frame.header.pixLength = dataSize;
+    tmp.mot = angle;
+    msg.frame.data[0] = tmp.octet[0];
+    msg.frame.data[1] = tmp.octet[1];
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetDefaultTurn (Word angle){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 2;
+    T_Word              tmp;
+    tmp.mot = angle;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_DEFTURN;
+    msg.frame.header.pixLength = dataSize;
+    tmp.mot = angle;
+    msg.frame.data[0] = tmp.octet[0];
+    msg.frame.data[1] = tmp.octet[1];
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndSetVector (Byte vectorIndex){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 1;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_VECTOR;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = vectorIndex;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndReverseVector (void){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 0;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_SET_REVERSE;
+    msg.frame.header.pixLength = dataSize;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_sndGetRGB (Word x, Word y, Byte saturate){
+    T_pixy2SendBuffer   msg;
+    int                 dataSize = 5;
+    msg.frame.header.pixSync = PIXY2_SYNC;
+    msg.frame.header.pixType = PIXY2_ASK_VIDEO;
+    msg.frame.header.pixLength = dataSize;
+    msg.frame.data[0] = x;
+    msg.frame.data[1] = y;
+    msg.frame.data[2] = saturate;
+    return pixy2_sndFrame (&msg, dataSize);
+}
+
+/*  La fonction est bloquante à l'envoi (pas vraiment le choix), mais elle est non bloquante en réception. On essayera de faire une fonction non bloquante en envoi avec write, mais c'est pas la priorité.
+Le principe c'est de stocker dans un buffer circulaire les données au fur et à mesure qu'elle sont reçues et de traiter uniquement en castant les infos. Pour cela, il faut recevoir et stocker. */
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getVersion (T_pixy2Version **ptrVersion){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if ((etat == idle) && versionValid) {                                           // La version ne change pas : elle n'est lue qu'une fois
+        *ptrVersion = &version;
+        return PIXY2_OK;
+    }
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetVersion();                                      // On envoie la trame de demande de la version
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_VERS, &cr)) {                          // On vérifie que la trame est du type convenable (REPONSE VERSION)
+                pixy2_setVersion ((T_pixy2Version*) &Pixy2_buffer[dPointer]);       // On garde la version et on en déduit les capacités du firmware
+                *ptrVersion = &version;
+            }
+            etat = idle;                                                            // On annonce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getResolution (T_pixy2Resolution **ptrResolution){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if ((etat == idle) && resolutionValid) {                                        // La résolution du programme courant est déjà connue
+        *ptrResolution = &resolution;                                               // Pas d'échange avec la caméra
+        return PIXY2_OK;
+    }
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetResolution();                                   // On envoie la trame de demande de la résolution
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_RESOL, &cr)) {                         // On vérifie que la trame est du type convenable (REPONSE RESOLUTION)
+                pixy2_setResolution ((T_pixy2Resolution*) &Pixy2_buffer[dPointer]); // On garde la résolution du programme courant en cache
+                *ptrResolution = &resolution;
+            }
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setCameraBrightness (Byte brightness){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetCameraBrightness (brightness);                  // On envoie la trame de règlage de la luminosité
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setServos (Word s0, Word s1){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetServo (s0, s1);                                 // On envoie la trame de règlage des servos moteurs
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            Pixy2_trajectoryActive = 0;                                             // Une consigne directe remplace la trajectoire en cours
+            servoPos[0] = s0;
+            servoPos[1] = s1;
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setLED (Byte red, Byte green, Byte blue){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetLED (red, green, blue);                         // On envoie la trame de règlage des composantes de la LED RGB
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setLamp (Byte upper, Byte lower){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetLamp (upper, lower);                            // On envoie la trame de règlage d'allumage des lumières de contraste
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getFPS (T_pixy2ReturnCode **framerate){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetFPS();                                          // On envoie la trame de demande du Framerate
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_FPS, &cr)) {                           // On vérifie que la trame est du type convenable (REPONSE FPS)
+                *framerate = (T_pixy2ReturnCode*) &Pixy2_buffer[dPointer];           // On mappe le pointeur de structure sur le buffer de réception.
+            }
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getBlocks (Byte sigmap, Byte maxBloc){
+    return pixy2_getFilteredBlocks (sigmap, maxBloc, NULL);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getFilteredBlocks (Byte sigmap, Byte maxBloc, Byte (*reject)(const T_pixy2Bloc*)){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    int                 i, kept, num;
+    Byte                stage;
+    T_pixy2Bloc         *blocks;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            if (pixy2_coalesce (((lWord) PIXY2_ASK_BLOC << 16) | (sigmap << 8) | maxBloc, reject, &cr)) return cr;   // Même requête à l'instant : mêmes résultats
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetBlocks(sigmap, maxBloc);                        // On envoie la trame de demande de blocs de couleur
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_BLOC, &cr)) {                          // On vérifie que la trame est du type convenable (REPONSE BLOCS)
+                blocks = (T_pixy2Bloc*) &Pixy2_buffer[dPointer];                    // On mappe le pointeur de structure sur le buffer de réception.
+                if (Pixy2_firstFrameTime == 0) Pixy2_firstFrameTime = (rxTime != createTime) ? rxTime - createTime : 1;    // Première trame de blocs valide depuis la construction
+                num = dataSize / sizeof(T_pixy2Bloc);                               // On indique le nombre de blocs reçus
+                if (reject != NULL) {                                               // Filtrage : on ne garde (en les tassant) que les blocs acceptés
+                    kept = 0;
+                    for (i = 0; i < num; i++) {
+                        stage = reject (&blocks[i]);
+                        Pixy2_filterCount[stage]++;                                 // Comptage par étage pour le réglage du filtre
+                        if (stage) continue;
+                        if (kept != i) blocks[kept] = blocks[i];
+                        kept++;
+                    }
+                    num = kept;
+                }
+                if (deferFrames != NULL) pixy2_deferBlocks (blocks, num);           // Les traitements seront faits par le thread de traitement
+                else {
+                    Pixy2_blocks = blocks;
+                    Pixy2_numBlocks = num;
+                    pixy2_processBlocks();                                          // On applique les traitements activés sur les blocs reçus
+                }
+                pixy2_coalesceStore (reject, cr);                                   // Résultats partagés avec les demandes identiques qui suivent
+            }
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getFeatures (){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    T_pixy2LineFeature* lineFeature;
+    int                 fPointer;                                                   // Pointeur sur une feature entière
+    int                 kind;                                                       // Rang de la feature (0 vecteurs, 1 intersections, 2 codebarres)
+
+    Pixy2_numVectors = 0;                                                           // Les features absentes de la trame ne doivent pas rester valides
+    Pixy2_numIntersections = 0;
+    Pixy2_numBarcodes = 0;
+    featurePresent = 0;
+    featureDecoded = 0;
+    if (pixy2_acceptReply (PIXY2_REP_LINE, &cr)) {                                  // On vérifie que la trame est du type convenable (REPONSE LIGNE)
+        fPointer = dPointer;                                                        // On pointe sur la premiere feature
+        while (fPointer + 2 <= dPointer + dataSize) {                               // Une seule passe : on indexe les features sans les décoder
+            lineFeature = (T_pixy2LineFeature*) &Pixy2_buffer[fPointer];            // On mappe le pointeur de structure sur le buffer de réception des features.
+            if (fPointer + 2 + lineFeature->fLength > dPointer + dataSize) break;   // Feature tronquée : on s'arrête là
+            kind = (lineFeature->fType == PIXY2_VECTOR) ? 0 : (lineFeature->fType == PIXY2_INTERSECTION) ? 1 : (lineFeature->fType == PIXY2_BARCODE) ? 2 : 3;
+            if (kind < 3) {                                                         // On mémorise où commence la feature et sa taille
+                featureOffset[kind] = fPointer + 2;
+                featureLength[kind] = lineFeature->fLength;
+                featurePresent |= lineFeature->fType;
+            }
+            fPointer += lineFeature->fLength + 2;                                   // On passe à la feature suivante (même si son type est inconnu)
+        }
+        cr |= featurePresent;
+        if (lazyFeatures) pixy2_processFeatures (trigVectors ? PIXY2_VECTOR : 0);  // Mode paresseux : seul ce qui est nécessaire aux déclencheurs est décodé
+        else pixy2_processFeatures (PIXY2_VECTOR | PIXY2_INTERSECTION | PIXY2_BARCODE);
+        if (trigVectors) pixy2_evalVectorTriggers();                                // Déclencheurs de franchissement de ligne
+        PIXY2_LOG (PIXY2_LOG_DEBUG, PIXY2_EVT_FEATURES, featurePresent, dataSize, 0);
+        pixy2_coalesceStore (NULL, cr);                                             // Résultats partagés avec les demandes identiques qui suivent
+    }
+    etat = idle;                                                                    // On annoce que la pixy est libre
+    return cr;
+}
+
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getMainFeature (Byte features){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            if (pixy2_coalesce (((lWord) PIXY2_ASK_LINE << 16) | features, NULL, &cr)) return cr;     // Même requête à l'instant : mêmes résultats
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetLineFeature(0, features);                       // On envoie la trame de demande de suivi de ligne
+            if (cr!= PIXY2_OK) return cr;                                          // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                    // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            cr = PIXY2::pixy2_getFeatures();                                        // On appelle la fonction de traitement.
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getAllFeature (Byte features){
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            if (pixy2_coalesce (((lWord) PIXY2_ASK_LINE << 16) | (1 << 8) | features, NULL, &cr)) return cr;
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetLineFeature(1, features);                       // On envoie la trame de demande de suivi de ligne
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            cr = PIXY2::pixy2_getFeatures();                                        // On appelle la fonction de traitement.
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setMode (Byte mode)
+{
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetMode (mode);                                    // On envoie la trame de règlage du mode de fonctionnement du suivi de ligne
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setNextTurn (sWord angle)
+{
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetNextTurn (angle);                               // On envoie la trame de choix de l'angle du prochain virage
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setDefaultTurn (sWord angle)
+{
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetDefaultTurn (angle);                            // On envoie la trame de choix de l'angle par défaut des virages
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setVector (Byte vectorIndex)
+{
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndSetVector (vectorIndex);                           // On envoie la trame de choix du vecteur à suivre
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_ReverseVector (void)
+{
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndReverseVector ();                                  // On envoie la trame d'inversion de l'image (haut en bas et bas en haut)
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+
+        case dataReceived :                                                         // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) cr = pixy2_readResult ();   // Acquittement : on copie le code reçu dans la variable de retour
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getRGB (Word x, Word y, Byte saturate, T_pixy2Pixel **pixel){
+
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+    
+    if (pixy2_streamServos()) return PIXY2_BUSY;                                    // Une mise à jour de trajectoire des servos occupe la liaison
+    switch (etat) {
+        case idle :                                                                 // Si la caméra est inactive
+            wPointer = 0;                                                           // On remonte en haut du buffer
+            cr = PIXY2::pixy2_sndGetRGB(x, y, saturate);                            // On envoie la trame de demande de la couleur (RGB) d'un carée de pixel
+            if (cr!= PIXY2_OK) return cr;                                           // S'il y a une erreur lors de l'envoi on ejecte !
+            etat = messageSent;                                                     // On passe à l'attente du message de réponse
+            cr = PIXY2_BUSY;                                                        // On signale à l'utilisateur que la caméra est maintenant occupée
+            break;
+            
+        case dataReceived :                                                      // Quand on a reçu l'intégralité du message
+            if (pixy2_acceptReply (PIXY2_REP_ACK, &cr)) {                           // On vérifie que la trame est du type convenable (REPONSE ACK)
+                *pixel = (T_pixy2Pixel*) &Pixy2_buffer[dPointer];                    // On mappe le pointeur de structure sur le buffer de réception.
+            }
+            etat = idle;                                                            // On annoce que la pixy est libre
+            break;
+
+        default :                                                                   // Dans tous les autres cas
+            cr = pixy2_checkPending();                                              // On signale que la caméra est occupée (ou ne répond plus).
+            break;
+    }
+    return cr;
+}
+
+
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_validateChecksum (Byte* tab){
+    Word    i, sum = 0;
+    T_Word  *tmp;
+    
+    for (i=0; i<*(tab+3);i++)   sum = sum + *(tab + PIXY2_CSHEADERSIZE + i);
+    tmp = (T_Word*) (tab+4);
+    
+    if (tmp->mot == sum) return PIXY2_OK;
+    else {
+        PIXY2_LOG (PIXY2_LOG_ERROR, PIXY2_EVT_BAD_CHECKSUM, *(tab+2), sum, tmp->mot);
+        linkStats.pixChecksumErrors++;
+        if (_DEBUG_) {
+            sommeDeControle = sum;
+            sommeRecue = tmp->mot;
+        }
+        return PIXY2_BAD_CHECKSUM;
+    }
+} 
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setBlocMerging (Byte enable, Word tolerance){
+    mergeEnable = enable;
+    mergeTolerance = tolerance;
+    Pixy2_numMergedBlocks = 0;                                                      // L'ancienne vue fusionnée n'est plus valide
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_processBlocks (void){
+    if (lensEnable) pixy2_correctBlocks();                                          // Correction de la distorsion (avant tout traitement géométrique)
+    if (normBuffer != NULL) pixy2_normaliseBlocks();                                // Coordonnées normalisées (après correction)
+    if (homography[PIXY2_GRID_BLOCS].enable) pixy2_groundBlocks();                  // Projection au sol
+    if (mergeEnable) pixy2_mergeBlocks();                                           // Fusion des fragments d'un même objet
+    if (clusterEnable) pixy2_clusterBlocks();                                       // Regroupement des objets proches
+    if (trackEnable) pixy2_trackBlocks();                                           // Association des blocs aux objets suivis
+    if (sigStats != NULL) pixy2_updateStats();                                      // Statistiques par signature (dérive de calibration)
+    if (heatEnable) pixy2_updateHeatmap();                                          // Accumulation dans la carte de chaleur
+    pixy2_evalBlocTriggers();                                                       // Déclencheurs sur régions d'intérêt
+    if (recEnable) pixy2_recordBlocks();                                            // Journal compact des détections
+    if (pubFrames != NULL) pixy2_publishBlocks();                                   // Publication pour les autres threads
+    PIXY2_LOG (PIXY2_LOG_DEBUG, PIXY2_EVT_BLOCS, Pixy2_numBlocks, Pixy2_numMergedBlocks, Pixy2_numTracks);
+}
+
+static void pixy2_siftDown (PIXY2::Byte *index, const PIXY2::lWord *key, int root, int end)
+{
+    int             child;
+    PIXY2::Byte     tmp;
+
+    while ((child = 2*root + 1) < end) {                                            // On fait descendre l'élément tant qu'un fils est plus grand
+        if ((child + 1 < end) && (key[index[child]] < key[index[child+1]])) child++;
+        if (key[index[root]] >= key[index[child]]) return;
+        tmp = index[root]; index[root] = index[child]; index[child] = tmp;
+        root = child;
+    }
+}
+
+void PIXY2::pixy2_sortIndex (Byte *index, const lWord *key, Byte n){
+    int     i;
+    Byte    tmp;
+
+    for (i = n/2 - 1; i >= 0; i--) pixy2_siftDown (index, key, i, n);              // Construction du tas
+    for (i = n - 1; i > 0; i--) {                                                   // Extraction : le maximum part en fin de tableau
+        tmp = index[0]; index[0] = index[i]; index[i] = tmp;
+        pixy2_siftDown (index, key, 0, i);
+    }
+}
+
+void PIXY2::pixy2_mergeBlocks (void){
+    sWord   left[PIXY2_MAX_BLOCS], right[PIXY2_MAX_BLOCS], top[PIXY2_MAX_BLOCS], bottom[PIXY2_MAX_BLOCS];
+    lWord   key[PIXY2_MAX_BLOCS];
+    Byte    index[PIXY2_MAX_BLOCS], parent[PIXY2_MAX_BLOCS], merged[PIXY2_MAX_BLOCS];
+    int     i, j, a, b, ri, rj, n;
+    lWord   start = us_ticker_read();
+    T_pixy2Bloc *bloc, *dest;
+
+    n = Pixy2_numBlocks;
+    if (n > PIXY2_MAX_BLOCS) n = PIXY2_MAX_BLOCS;
+    for (i = 0; i < n; i++) {                                                       // On calcule la boite englobante de chaque bloc
+        bloc = &Pixy2_blocks[i];
+        left[i] = bloc->pixX - bloc->pixWidth / 2;
+        top[i] = bloc->pixY - bloc->pixHeight / 2;
+        if (left[i] < 0) left[i] = 0;
+        if (top[i] < 0) top[i] = 0;
+        right[i] = left[i] + bloc->pixWidth;
+        bottom[i] = top[i] + bloc->pixHeight;
+        key[i] = ((lWord) bloc->pixSignature << 16) | (Word) left[i];               // Tri par signature puis par bord gauche
+        index[i] = i;
+        parent[i] = i;
+    }
+    pixy2_sortIndex (index, key, n);
+
+    for (a = 0; a < n; a++) {                                                       // Balayage : on ne compare qu'aux blocs qui commencent avant la fin du bloc courant
+        i = index[a];
+        for (b = a + 1; b < n; b++) {
+            j = index[b];
+            if (Pixy2_blocks[j].pixSignature != Pixy2_blocks[i].pixSignature) break;
+            if (left[j] > right[i] + mergeTolerance) break;
+            if ((top[j] > bottom[i] + mergeTolerance) || (top[i] > bottom[j] + mergeTolerance)) continue;
+            ri = i;                                                                 // Union des deux ensembles (union-find)
+            while (parent[ri] != ri) {
+                parent[ri] = parent[parent[ri]];
+                ri = parent[ri];
+            }
+            rj = j;
+            while (parent[rj] != rj) {
+                parent[rj] = parent[parent[rj]];
+                rj = parent[rj];
+            }
+            if (ri < rj) parent[rj] = ri;                                           // Le représentant est le plus gros bloc (les blocs sont triés par aire)
+            else parent[ri] = rj;
+        }
+    }
+
+    Pixy2_numMergedBlocks = 0;
+    for (i = 0; i < n; i++) {                                                       // On construit la vue fusionnée dans l'ordre des représentants
+        ri = i;
+        while (parent[ri] != ri) ri = parent[ri];
+        if (ri == i) {                                                              // Nouveau représentant : on crée le bloc fusionné
+            merged[i] = Pixy2_numMergedBlocks++;
+            Pixy2_mergedBlocks[merged[i]] = Pixy2_blocks[i];
+            right[merged[i]] = right[i];                                            // On réutilise les tableaux déjà parcourus pour la boite fusionnée
+            bottom[merged[i]] = bottom[i];
+            left[merged[i]] = left[i];
+            top[merged[i]] = top[i];
+        } else {                                                                    // Fragment : on étend la boite de son représentant
+            j = merged[ri];
+            if (left[i] < left[j]) left[j] = left[i];
+            if (top[i] < top[j]) top[j] = top[i];
+            if (right[i] > right[j]) right[j] = right[i];
+            if (bottom[i] > bottom[j]) bottom[j] = bottom[i];
+            if (Pixy2_blocks[i].pixAge > Pixy2_mergedBlocks[j].pixAge) Pixy2_mergedBlocks[j].pixAge = Pixy2_blocks[i].pixAge;   // Âge du plus vieux fragment
+        }
+    }
+    for (j = 0; j < Pixy2_numMergedBlocks; j++) {                                   // On recalcule centre et taille des blocs fusionnés
+        dest = &Pixy2_mergedBlocks[j];
+        dest->pixX = (left[j] + right[j]) / 2;
+        dest->pixY = (top[j] + bottom[j]) / 2;
+        dest->pixWidth = right[j] - left[j];
+        dest->pixHeight = bottom[j] - top[j];
+    }
+    Pixy2_mergeTime = us_ticker_read() - start;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setClustering (Byte enable, Word eps, Byte minBlocs){
+    if (eps == 0) eps = 1;                                                          // Un rayon nul n'a pas de sens (et la grille serait de taille infinie)
+    clusterEnable = enable;
+    clusterEps = eps;
+    clusterMinBlocs = minBlocs;
+    Pixy2_numClusters = 0;
+    return PIXY2_OK;
+}
+
+static PIXY2::Byte pixy2_regionQuery (const PIXY2::T_pixy2Bloc *blocs, const PIXY2::Byte *index, const PIXY2::lWord *key, PIXY2::Byte n, PIXY2::Byte p, PIXY2::Word eps, PIXY2::Byte *result)
+{
+    long            cx = blocs[p].pixX / eps, cy = blocs[p].pixY / eps;
+    long            col, first, last, mid, dx, dy;
+    PIXY2::lWord    low, high;
+    PIXY2::Byte     count = 0;
+
+    for (col = cx - 1; col <= cx + 1; col++) {                                      // On parcourt les 3 colonnes de cellules autour du bloc
+        if (col < 0) continue;
+        low = ((PIXY2::lWord) col << 16) | (PIXY2::Word) (cy > 0 ? cy - 1 : 0);
+        high = ((PIXY2::lWord) col << 16) | (PIXY2::Word) (cy + 1);
+        first = 0;                                                                  // Recherche dichotomique de la première cellule de la colonne
+        last = n;
+        while (first < last) {
+            mid = (first + last) / 2;
+            if (key[index[mid]] < low) first = mid + 1;
+            else last = mid;
+        }
+        while ((first < n) && (key[index[first]] <= high)) {                        // Les 3 cellules d'une colonne sont contigües : on teste la distance réelle
+            dx = (long) blocs[index[first]].pixX - blocs[p].pixX;
+            dy = (long) blocs[index[first]].pixY - blocs[p].pixY;
+            if (dx * dx + dy * dy <= (long) eps * eps) result[count++] = index[first];
+            first++;
+        }
+    }
+    return count;
+}
+
+void PIXY2::pixy2_clusterBlocks (void){
+    T_pixy2Bloc     *blocs = Pixy2_blocks;
+    lWord           key[PIXY2_MAX_BLOCS];
+    Byte            index[PIXY2_MAX_BLOCS], neighbours[PIXY2_MAX_BLOCS], stack[PIXY2_MAX_BLOCS];
+    Byte            visited[PIXY2_MAX_BLOCS];
+    int             i, j, k, n, sp, nb, left, top;
+    lWord           start = us_ticker_read(), sumX, sumY;
+    T_pixy2Cluster  *cluster;
+
+    n = Pixy2_numBlocks;
+    if (mergeEnable) {                                                              // On travaille sur les blocs fusionnés s'ils existent
+        blocs = Pixy2_mergedBlocks;
+        n = Pixy2_numMergedBlocks;
+    }
+    if (n > PIXY2_MAX_BLOCS) n = PIXY2_MAX_BLOCS;
+    for (i = 0; i < n; i++) {                                                       // On range chaque bloc dans sa cellule de la grille
+        key[i] = ((lWord) (blocs[i].pixX / clusterEps) << 16) | (Word) (blocs[i].pixY / clusterEps);
+        index[i] = i;
+        visited[i] = 0;
+        Pixy2_blocCluster[i] = PIXY2_NOISE;
+    }
+    pixy2_sortIndex (index, key, n);
+
+    Pixy2_numClusters = 0;
+    for (i = 0; i < n; i++) {
+        if (visited[i]) continue;
+        visited[i] = 1;
+        nb = pixy2_regionQuery (blocs, index, key, n, i, clusterEps, neighbours);
+        if (nb < clusterMinBlocs) continue;                                         // Ce n'est pas un bloc coeur (il pourra être rattaché plus tard)
+        Pixy2_blocCluster[i] = Pixy2_numClusters;                                   // Nouveau cluster : on l'étend depuis ce bloc coeur
+        sp = 0;
+        for (k = 0; k < nb; k++) {
+            j = neighbours[k];
+            if (Pixy2_blocCluster[j] == PIXY2_NOISE) {
+                Pixy2_blocCluster[j] = Pixy2_numClusters;
+                if (!visited[j]) stack[sp++] = j;                                   // Chaque bloc n'est empilé qu'une fois : la pile ne déborde pas
+            }
+        }
+        while (sp > 0) {
+            j = stack[--sp];
+            visited[j] = 1;
+            nb = pixy2_regionQuery (blocs, index, key, n, j, clusterEps, neighbours);
+            if (nb < clusterMinBlocs) continue;                                     // Bloc de bordure : on ne s'étend pas depuis lui
+            for (k = 0; k < nb; k++) {
+                if (Pixy2_blocCluster[neighbours[k]] == PIXY2_NOISE) {
+                    Pixy2_blocCluster[neighbours[k]] = Pixy2_numClusters;
+                    if (!visited[neighbours[k]]) stack[sp++] = neighbours[k];
+                }
+            }
+        }
+        Pixy2_numClusters++;
+    }
+
+    for (k = 0; k < Pixy2_numClusters; k++) {                                       // On calcule centroïde, boite englobante et membres de chaque cluster
+        cluster = &Pixy2_clusters[k];
+        cluster->pixLeft = cluster->pixTop = 0xFFFF;
+        cluster->pixRight = cluster->pixBottom = 0;
+        cluster->pixNumBlocs = 0;
+        cluster->pixMembers = 0;
+        sumX = sumY = 0;
+        for (i = 0; i < n; i++) {
+            if (Pixy2_blocCluster[i] != k) continue;
+            sumX += blocs[i].pixX;
+            sumY += blocs[i].pixY;
+            left = blocs[i].pixX - blocs[i].pixWidth / 2;
+            top = blocs[i].pixY - blocs[i].pixHeight / 2;
+            if (left < 0) left = 0;
+            if (top < 0) top = 0;
+            if (left < cluster->pixLeft) cluster->pixLeft = left;
+            if (top < cluster->pixTop) cluster->pixTop = top;
+            if (left + blocs[i].pixWidth > cluster->pixRight) cluster->pixRight = left + blocs[i].pixWidth;
+            if (top + blocs[i].pixHeight > cluster->pixBottom) cluster->pixBottom = top + blocs[i].pixHeight;
+            cluster->pixNumBlocs++;
+            cluster->pixMembers |= 1UL << i;
+        }
+        cluster->pixX = sumX / cluster->pixNumBlocs;
+        cluster->pixY = sumY / cluster->pixNumBlocs;
+    }
+    Pixy2_clusterTime = us_ticker_read() - start;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setTracking (Byte enable, Word gate, Byte maxMissed){
+    if (maxMissed == 0xFF) return PIXY2_MISC_ERROR;                                 // pixMissed (8 bits) ne pourrait jamais le dépasser : les objets perdus ne seraient jamais supprimés
+    trackEnable = enable;
+    trackGate = gate;
+    trackMaxMissed = maxMissed;
+    Pixy2_numTracks = 0;                                                            // On repart sans objet suivi
+    Pixy2_trackWorstTime = 0;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_trackBlocks (void){
+    long            (*cost)[PIXY2_MAX_BLOCS + 1] = trackCost;                        // Matrice des coûts (indices à partir de 1), propre à chaque caméra
+    long            u[PIXY2_MAX_BLOCS + 1], v[PIXY2_MAX_BLOCS + 1], minv[PIXY2_MAX_BLOCS + 1];
+    Byte            p[PIXY2_MAX_BLOCS + 1], way[PIXY2_MAX_BLOCS + 1], used[PIXY2_MAX_BLOCS + 1];
+    T_pixy2Bloc     *blocs = Pixy2_blocks;
+    T_pixy2Track    *track;
+    int             i, j, j0, j1, n, nBlocs, nTracks, size;
+    long            delta, c, forbidden;
+    lWord           start = us_ticker_read();
+
+    nBlocs = Pixy2_numBlocks;
+    if (mergeEnable) {                                                              // On travaille sur les blocs fusionnés s'ils existent
+        blocs = Pixy2_mergedBlocks;
+        nBlocs = Pixy2_numMergedBlocks;
+    }
+    if (nBlocs > PIXY2_MAX_BLOCS) nBlocs = PIXY2_MAX_BLOCS;
+    nTracks = Pixy2_numTracks;
+    size = (nTracks > nBlocs) ? nTracks : nBlocs;                                   // Matrice carrée : les lignes ou colonnes manquantes sont fictives
+    forbidden = (long) (size + 1) * (trackGate + 1);                                // Plus cher que toute somme d'associations autorisées
+
+    for (i = 1; i <= size; i++) {                                                   // Lignes = objets suivis, colonnes = blocs
+        for (j = 1; j <= size; j++) {
+            cost[i][j] = forbidden;
+            if ((i > nTracks) || (j > nBlocs)) continue;
+            track = &Pixy2_tracks[i-1];
+            if (track->pixBloc.pixSignature != blocs[j-1].pixSignature) continue;  // Une signature différente interdit l'association
+            c = labs ((long) track->pixBloc.pixX - blocs[j-1].pixX) + labs ((long) track->pixBloc.pixY - blocs[j-1].pixY);
+            c += (labs ((long) track->pixBloc.pixWidth - blocs[j-1].pixWidth) + labs ((long) track->pixBloc.pixHeight - blocs[j-1].pixHeight)) / 2;
+            if (c <= trackGate) cost[i][j] = c;                                     // Hors de la porte, l'association reste interdite
+        }
+    }
+
+    for (j = 0; j <= size; j++) {                                                   // Algorithme hongrois (potentiels u et v, chemins augmentants)
+        u[j] = v[j] = 0;
+        p[j] = 0;
+    }
+    for (i = 1; i <= size; i++) {
+        p[0] = i;
+        j0 = 0;
+        for (j = 0; j <= size; j++) {
+            minv[j] = 0x7FFFFFFFL;
+            used[j] = 0;
+        }
+        do {
+            used[j0] = 1;
+            n = p[j0];
+            delta = 0x7FFFFFFFL;
+            j1 = 0;
+            for (j = 1; j <= size; j++) {
+                if (used[j]) continue;
+                c = cost[n][j] - u[n] - v[j];
+                if (c < minv[j]) {
+                    minv[j] = c;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (j = 0; j <= size; j++) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else minv[j] -= delta;
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {                                                                        // On inverse le chemin augmentant trouvé
+            j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    for (j = 0; j < nBlocs; j++) Pixy2_blocTrack[j] = PIXY2_NO_TRACK;
+    for (i = 0; i < nTracks; i++) {                                                 // Chaque objet est réputé perdu jusqu'à preuve du contraire
+        if (Pixy2_tracks[i].pixMissed < 0xFF) Pixy2_tracks[i].pixMissed++;          // Saturé : le compteur ne revient jamais à 0
+    }
+    for (j = 1; j <= nBlocs; j++) {                                                 // On met à jour les objets associés (coût autorisé uniquement)
+        i = p[j];
+        if ((i > nTracks) || (cost[i][j] >= forbidden)) continue;
+        track = &Pixy2_tracks[i-1];
+        track->pixBloc = blocs[j-1];
+        track->pixMissed = 0;
+        if (track->pixAge < 0xFFFF) track->pixAge++;
+        Pixy2_blocTrack[j-1] = track->pixId;
+    }
+    j = 0;
+    for (i = 0; i < nTracks; i++) {                                                 // On supprime les objets perdus depuis trop longtemps
+        if (Pixy2_tracks[i].pixMissed > trackMaxMissed) continue;
+        Pixy2_tracks[j++] = Pixy2_tracks[i];
+    }
+    Pixy2_numTracks = j;
+    for (j = 0; j < nBlocs; j++) {                                                  // Les blocs non associés deviennent de nouveaux objets
+        if ((Pixy2_blocTrack[j] != PIXY2_NO_TRACK) || (Pixy2_numTracks >= PIXY2_MAX_TRACKS)) continue;
+        track = &Pixy2_tracks[Pixy2_numTracks++];
+        track->pixId = trackNextId;
+        track->pixMissed = 0;
+        track->pixAge = 1;
+        track->pixBloc = blocs[j];
+        Pixy2_blocTrack[j] = trackNextId;
+        trackNextId = (trackNextId == 0xFF) ? 1 : trackNextId + 1;                  // L'identifiant 0 est réservé (PIXY2_NO_TRACK)
+    }
+
+    Pixy2_trackTime = us_ticker_read() - start;
+    if (Pixy2_trackTime > Pixy2_trackWorstTime) Pixy2_trackWorstTime = Pixy2_trackTime;
+}
+
+void PIXY2::pixy2_processFeatures (Byte features){
+    features &= featurePresent & ~featureDecoded;                                   // Chaque feature n'est décodée qu'une fois
+    if (!features) return;
+    if (features & PIXY2_VECTOR) {                                                  // On mappe les résultats sur le buffer de réception
+        Pixy2_vectors = (T_pixy2Vector*) &Pixy2_buffer[featureOffset[0]];
+        Pixy2_numVectors = featureLength[0] / sizeof(T_pixy2Vector);
+    }
+    if (features & PIXY2_INTERSECTION) {
+        Pixy2_intersections = (T_pixy2Intersection*) &Pixy2_buffer[featureOffset[1]];
+        Pixy2_numIntersections = featureLength[1] / sizeof(T_pixy2Intersection);
+    }
+    if (features & PIXY2_BARCODE) {
+        Pixy2_barcodes = (T_pixy2BarCode*) &Pixy2_buffer[featureOffset[2]];
+        Pixy2_numBarcodes = featureLength[2] / sizeof(T_pixy2BarCode);
+    }
+    if (lensEnable) pixy2_correctFeatures (features);                               // Correction de la distorsion
+    if (normBuffer != NULL) pixy2_normaliseFeatures (features);                     // Coordonnées normalisées
+    if (homography[PIXY2_GRID_LINE].enable) pixy2_groundFeatures (features);        // Projection au sol
+    featureDecoded |= features;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setLazyFeatures (Byte enable){
+    lazyFeatures = enable;
+    return PIXY2_OK;
+}
+
+PIXY2::Byte PIXY2::pixy2_lineVectors (T_pixy2Vector **vectors){
+    pixy2_processFeatures (PIXY2_VECTOR);                                           // Décodage au premier accès
+    *vectors = Pixy2_vectors;
+    return Pixy2_numVectors;
+}
+
+PIXY2::Byte PIXY2::pixy2_lineIntersections (T_pixy2Intersection **intersections){
+    pixy2_processFeatures (PIXY2_INTERSECTION);                                     // Décodage au premier accès
+    *intersections = Pixy2_intersections;
+    return Pixy2_numIntersections;
+}
+
+PIXY2::Byte PIXY2::pixy2_lineBarcodes (T_pixy2BarCode **barcodes){
+    pixy2_processFeatures (PIXY2_BARCODE);                                          // Décodage au premier accès
+    *barcodes = Pixy2_barcodes;
+    return Pixy2_numBarcodes;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setLensCorrection (Byte enable, Word width, Word height, float k1, float k2){
+    int     i, k;
+    float   rd, ru, factor;
+
+    lensEnable = 0;                                                                 // Pas de correction pendant la construction de la table
+    if (!enable) return PIXY2_OK;
+    if ((width == 0) || (height == 0)) return PIXY2_MISC_ERROR;
+    for (i = 0; i < PIXY2_LENS_SIZE; i++) {                                         // On inverse le modèle pour chaque rd^2 de la table
+        rd = sqrtf ((float) i / (PIXY2_LENS_SIZE - 1));
+        ru = rd;
+        for (k = 0; k < 20; k++) ru = rd / (1.0f + k1 * ru * ru + k2 * ru * ru * ru * ru);
+                                                                                    // Point fixe : converge pour les distorsions usuelles (|k| < 0.5)
+        factor = (rd > 0.0f) ? ru / rd : 1.0f;                                  // Au centre le facteur vaut 1
+        if (factor < 0.0f) factor = 0.0f;
+        if (factor > 3.99f) factor = 3.99f;                                         // Le facteur doit tenir en Q14 sur 16 bits
+        lensTable[i] = (Word) (factor * 16384.0f + 0.5f);
+    }
+    pixy2_setLensGrid (&lensBlocs, width, height);
+    pixy2_setLensGrid (&lensLine, PIXY2_LINE_WIDTH, PIXY2_LINE_HEIGHT);
+    lensEnable = 1;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_setLensGrid (T_pixy2LensGrid *grid, Word width, Word height){
+    lWord   halfDiag2;
+
+    grid->cx = width / 2;
+    grid->cy = height / 2;
+    grid->maxX = width - 1;
+    grid->maxY = height - 1;
+    halfDiag2 = (lWord) grid->cx * grid->cx + (lWord) grid->cy * grid->cy;         // Carré de la demi-diagonale (rd = 1)
+    if (halfDiag2 == 0) halfDiag2 = 1;
+    grid->scaleR2 = (((lWord) (PIXY2_LENS_SIZE - 1) << 24) + halfDiag2 / 2) / halfDiag2;
+}
+
+void PIXY2::pixy2_correctPoint (const T_pixy2LensGrid *grid, Word *x, Word *y){
+    long    dx = (long) *x - grid->cx, dy = (long) *y - grid->cy;
+    lWord   pos, frac;
+    long    factor, nx, ny;
+
+    pos = ((lWord) (dx * dx + dy * dy) * grid->scaleR2) >> 16;                     // Position dans la table (Q8)
+    frac = pos & 0xFF;
+    pos >>= 8;
+    if (pos >= PIXY2_LENS_SIZE - 1) {                                               // Au delà de la demi-diagonale on garde le dernier facteur
+        factor = lensTable[PIXY2_LENS_SIZE - 1];
+    } else {                                                                        // Sinon interpolation linéaire entre deux entrées
+        factor = lensTable[pos] + ((((long) lensTable[pos + 1] - lensTable[pos]) * (long) frac) >> 8);
+    }
+    nx = grid->cx + ((dx * factor + 8192) >> 14);
+    ny = grid->cy + ((dy * factor + 8192) >> 14);
+    if (nx < 0) nx = 0;
+    if (ny < 0) ny = 0;
+    if (nx > grid->maxX) nx = grid->maxX;
+    if (ny > grid->maxY) ny = grid->maxY;
+    *x = nx;
+    *y = ny;
+}
+
+void PIXY2::pixy2_correctBlocks (void){
+    int     i;
+    Word    x, y;
+
+    for (i = 0; i < Pixy2_numBlocks; i++) {                                         // On corrige le centre de chaque bloc
+        x = Pixy2_blocks[i].pixX;
+        y = Pixy2_blocks[i].pixY;
+        pixy2_correctPoint (&lensBlocs, &x, &y);
+        Pixy2_blocks[i].pixX = x;
+        Pixy2_blocks[i].pixY = y;
+    }
+}
+
+void PIXY2::pixy2_correctFeatures (Byte features){
+    int     i;
+    Word    x, y;
+
+    for (i = 0; (features & PIXY2_VECTOR) && (i < Pixy2_numVectors); i++) {         // Queue et tête de chaque vecteur
+        x = Pixy2_vectors[i].pixX0;
+        y = Pixy2_vectors[i].pixY0;
+        pixy2_correctPoint (&lensLine, &x, &y);
+        Pixy2_vectors[i].pixX0 = x;
+        Pixy2_vectors[i].pixY0 = y;
+        x = Pixy2_vectors[i].pixX1;
+        y = Pixy2_vectors[i].pixY1;
+        pixy2_correctPoint (&lensLine, &x, &y);
+        Pixy2_vectors[i].pixX1 = x;
+        Pixy2_vectors[i].pixY1 = y;
+    }
+    for (i = 0; (features & PIXY2_INTERSECTION) && (i < Pixy2_numIntersections); i++) {
+        x = Pixy2_intersections[i].pixX;
+        y = Pixy2_intersections[i].pixY;
+        pixy2_correctPoint (&lensLine, &x, &y);
+        Pixy2_intersections[i].pixX = x;
+        Pixy2_intersections[i].pixY = y;
+    }
+    for (i = 0; (features & PIXY2_BARCODE) && (i < Pixy2_numBarcodes); i++) {
+        x = Pixy2_barcodes[i].pixX;
+        y = Pixy2_barcodes[i].pixY;
+        pixy2_correctPoint (&lensLine, &x, &y);
+        Pixy2_barcodes[i].pixX = x;
+        Pixy2_barcodes[i].pixY = y;
+    }
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setHomography (Byte enable, Byte grid, const float *h){
+    int     i;
+    float   coef;
+
+    if (grid > PIXY2_GRID_LINE) return PIXY2_MISC_ERROR;
+    homography[grid].enable = 0;                                                    // Pas de projection pendant la mise à jour de la matrice
+    if (!enable) return PIXY2_OK;
+    if ((h[8] > -1e-9f) && (h[8] < 1e-9f)) return PIXY2_MISC_ERROR;                 // On ne peut pas normaliser la matrice
+    for (i = 0; i < 9; i++) {                                                       // Conversion en virgule fixe (Q32) de la matrice normalisée
+        coef = h[i] / h[8];                                                         // Q32 : les faibles termes de perspective (h6, h7) restent précis
+        if ((coef > 1048575.0f) || (coef < -1048575.0f)) return PIXY2_MISC_ERROR;      // Limite pour que m.x + m.y + m tienne sur 64 bits
+        homography[grid].m[i] = (long long) (coef * 4294967296.0f);
+    }
+    homography[grid].enable = 1;
+    return PIXY2_OK;
+}
+
+static long long pixy2_roundDiv (long long num, long long den)
+{
+    return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;              // Division arrondie au plus proche (den > 0)
+}
+
+void PIXY2::pixy2_transformPoints (const T_pixy2Homography *h, T_pixy2GroundPoint *points, int n){
+    const long long *m = h->m;
+    long long       x, y, den;
+    int             i;
+
+    for (i = 0; i < n; i++) {                                                       // Numérateurs et dénominateur en Q32, le quotient est en unité sol
+        x = points[i].pixX;
+        y = points[i].pixY;
+        den = m[6] * x + m[7] * y + m[8];
+        if (den <= 0) {                                                             // Point au dessus de l'horizon : pas de projection
+            points[i].pixX = points[i].pixY = PIXY2_GROUND_NONE;
+            continue;
+        }
+        points[i].pixX = (slWord) pixy2_roundDiv (m[0] * x + m[1] * y + m[2], den);
+        points[i].pixY = (slWord) pixy2_roundDiv (m[3] * x + m[4] * y + m[5], den);
+    }
+}
+
+void PIXY2::pixy2_groundBlocks (void){
+    int     i, n = Pixy2_numBlocks;
+    lWord   start = us_ticker_read();
+
+    if (n > PIXY2_MAX_BLOCS) n = PIXY2_MAX_BLOCS;
+    for (i = 0; i < n; i++) {                                                       // On rassemble les centres puis on les transforme d'un coup
+        Pixy2_groundBlocks[i].pixX = Pixy2_blocks[i].pixX;
+        Pixy2_groundBlocks[i].pixY = Pixy2_blocks[i].pixY;
+    }
+    pixy2_transformPoints (&homography[PIXY2_GRID_BLOCS], Pixy2_groundBlocks, n);
+    Pixy2_groundPoints = n;
+    Pixy2_groundTime = us_ticker_read() - start;
+}
+
+void PIXY2::pixy2_groundFeatures (Byte features){
+    int     i, nv = 0, ni = 0;
+    lWord   start = us_ticker_read();
+
+    if (features & PIXY2_VECTOR) nv = Pixy2_numVectors;
+    if (features & PIXY2_INTERSECTION) ni = Pixy2_numIntersections;
+    if (nv > PIXY2_MAX_VECTORS) nv = PIXY2_MAX_VECTORS;
+    if (ni > PIXY2_MAX_INTERS) ni = PIXY2_MAX_INTERS;
+    for (i = 0; i < nv; i++) {                                                      // On rassemble les extrémités des vecteurs...
+        Pixy2_groundVectors[i][0].pixX = Pixy2_vectors[i].pixX0;
+        Pixy2_groundVectors[i][0].pixY = Pixy2_vectors[i].pixY0;
+        Pixy2_groundVectors[i][1].pixX = Pixy2_vectors[i].pixX1;
+        Pixy2_groundVectors[i][1].pixY = Pixy2_vectors[i].pixY1;
+    }
+    for (i = 0; i < ni; i++) {                                                      // ... et les intersections
+        Pixy2_groundIntersections[i].pixX = Pixy2_intersections[i].pixX;
+        Pixy2_groundIntersections[i].pixY = Pixy2_intersections[i].pixY;
+    }
+    pixy2_transformPoints (&homography[PIXY2_GRID_LINE], &Pixy2_groundVectors[0][0], 2 * nv);
+    pixy2_transformPoints (&homography[PIXY2_GRID_LINE], Pixy2_groundIntersections, ni);
+    Pixy2_groundPoints = 2 * nv + ni;
+    Pixy2_groundTime = us_ticker_read() - start;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setHeatmap (Byte enable, Word width, Word height, Word halfLife){
+    int     i;
+
+    heatEnable = 0;
+    if (!enable) return PIXY2_OK;
+    if ((width == 0) || (height == 0)) return PIXY2_MISC_ERROR;
+    heatHalfLife = (halfLife == 0) ? 1 : halfLife;
+    heatScaleX = ((lWord) PIXY2_HEAT_COLS << 16) / width;                           // Taille des cellules déduite de la résolution
+    heatScaleY = ((lWord) PIXY2_HEAT_ROWS << 16) / height;
+    heatFrame = 0;
+    core_util_atomic_store_u32 (&heatSeq, 0);
+    for (i = 0; i < PIXY2_HEAT_ROWS * PIXY2_HEAT_COLS; i++) {
+        heatValue[i] = 0;
+        heatEpoch[i] = 0;
+    }
+    heatEnable = 1;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_updateHeatmap (void){
+    T_pixy2Bloc     *blocs = Pixy2_blocks;
+    int             i, n = Pixy2_numBlocks;
+    lWord           epoch, elapsed, col, row, cell, heat;
+    uint32_t        seq = core_util_atomic_load_u32 (&heatSeq);                     // Un seul écrivain : le thread qui décode les trames
+
+    if (mergeEnable) {                                                              // On travaille sur les blocs fusionnés s'ils existent
+        blocs = Pixy2_mergedBlocks;
+        n = Pixy2_numMergedBlocks;
+    }
+    core_util_atomic_store_u32 (&heatSeq, seq + 1);                                 // Impair : mise à jour en cours (voir pixy2_getHeatmap)
+    __DMB();                                                                        // Le numéro impair est visible avant toute écriture de cellule
+    heatFrame++;
+    epoch = heatFrame / heatHalfLife;
+    for (i = 0; i < n; i++) {
+        col = (blocs[i].pixX * heatScaleX) >> 16;
+        row = (blocs[i].pixY * heatScaleY) >> 16;
+        if (col >= PIXY2_HEAT_COLS) col = PIXY2_HEAT_COLS - 1;
+        if (row >= PIXY2_HEAT_ROWS) row = PIXY2_HEAT_ROWS - 1;
+        cell = row * PIXY2_HEAT_COLS + col;
+        elapsed = epoch - heatEpoch[cell];                                          // Décroissance paresseuse : une division par 2 par demi-vie écoulée
+        heat = (elapsed < 16) ? (heatValue[cell] >> elapsed) : 0;
+        heat += PIXY2_HEAT_HIT;
+        heatValue[cell] = (heat > 0xFFFF) ? 0xFFFF : heat;
+        heatEpoch[cell] = epoch;
+    }
+    __DMB();                                                                        // Toutes les cellules sont écrites avant le numéro pair
+    core_util_atomic_store_u32 (&heatSeq, seq + 2);                                 // Pair : la carte est cohérente
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getHeatmap (Word *snapshot){
+    lWord       epoch, elapsed;
+    uint32_t    seq;
+    int         i;
+
+    if (!heatEnable) return PIXY2_MISC_ERROR;
+    do {                                                                            // Lecture optimiste : on recommence si une trame a été ajoutée pendant la copie
+        seq = core_util_atomic_load_u32 (&heatSeq);                                 // Lecture avec barrière : la copie ne remonte pas avant
+        if (seq & 1) continue;
+        epoch = heatFrame / heatHalfLife;
+        for (i = 0; i < PIXY2_HEAT_ROWS * PIXY2_HEAT_COLS; i++) {
+            elapsed = epoch - heatEpoch[i];
+            snapshot[i] = (elapsed < 16) ? (heatValue[i] >> elapsed) : 0;
+        }
+        __DMB();                                                                    // La copie est terminée avant de relire le numéro de séquence
+    } while ((seq & 1) || (seq != core_util_atomic_load_u32 (&heatSeq)));
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setTrigger (Byte number, const T_pixy2Trigger *trigger){
+    Byte    bit;
+    int     i;
+
+    if (number >= PIXY2_MAX_TRIGGERS) return PIXY2_MISC_ERROR;
+    bit = 1 << number;
+    for (i = 0; i < 8; i++) trigBySig[i] &= ~bit;                                   // On retire l'ancienne entrée de la table compilée
+    trigVectors &= ~bit;
+    Pixy2_triggerState &= ~bit;
+    trigCount[number] = 0;
+    if ((trigger == NULL) || (trigger->pixType == PIXY2_TRIG_NONE)) {
+        triggers[number].pixType = PIXY2_TRIG_NONE;
+        return PIXY2_OK;
+    }
+    triggers[number] = *trigger;
+    if (triggers[number].pixOnFrames == 0) triggers[number].pixOnFrames = 1;
+    if (triggers[number].pixOffFrames == 0) triggers[number].pixOffFrames = 1;
+    if (trigger->pixType == PIXY2_TRIG_VECTOR) {
+        trigVectors |= bit;
+    } else {
+        for (i = 0; i < 8; i++) {                                                   // Pour chaque signature, masque des déclencheurs concernés
+            if (trigger->pixSigmap & (1 << i)) trigBySig[i] |= bit;
+        }
+    }
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_attachTrigger (Callback<void(Byte, Byte)> function){
+    trigCallback = function;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_updateTriggers (Byte mask, Byte matched){
+    int             i;
+    Byte            bit, active, edges = 0, state;
+    T_pixy2Trigger  *trigger;
+
+    core_util_critical_section_enter();                                             // Déclencheurs de blocs et de vecteurs peuvent être évalués par deux threads (voir pixy2_setDeferred)
+    for (i = 0; i < PIXY2_MAX_TRIGGERS; i++) {
+        bit = 1 << i;
+        if (!(mask & bit)) continue;
+        trigger = &triggers[i];
+        active = (Pixy2_triggerState & bit) ? 1 : 0;
+        if (((matched & bit) ? 1 : 0) == active) {                                  // La trame confirme l'état courant
+            trigCount[i] = 0;
+            continue;
+        }
+        trigCount[i]++;                                                             // La trame contredit l'état : hystérésis
+        if (trigCount[i] < (active ? trigger->pixOffFrames : trigger->pixOnFrames)) continue;
+        trigCount[i] = 0;
+        Pixy2_triggerState ^= bit;                                                  // Front : on change d'état
+        edges |= bit;
+    }
+    state = Pixy2_triggerState;
+    core_util_critical_section_exit();
+    if (!trigCallback) return;
+    for (i = 0; edges; i++) {                                                       // L'abonné est prévenu hors de la section critique
+        bit = 1 << i;
+        if (!(edges & bit)) continue;
+        edges &= ~bit;
+        trigCallback (i, (state & bit) ? 1 : 0);
+    }
+}
+
+void PIXY2::pixy2_evalBlocTriggers (void){
+    Byte            mask = 0, matched = 0, candidates, bit;
+    int             i, k, sig;
+    lWord           area;
+    T_pixy2Bloc     *bloc;
+    T_pixy2Trigger  *trigger;
+
+    for (k = 0; k < 8; k++) mask |= trigBySig[k];
+    if (!mask) return;
+    for (i = 0; i < Pixy2_numBlocks; i++) {
+        bloc = &Pixy2_blocks[i];
+        sig = (bloc->pixSignature >= 1 && bloc->pixSignature <= 7) ? bloc->pixSignature - 1 : 7;
+                                                                                    // Signatures 1 à 7 : bits 0 à 6, codes couleur : bit 7
+        candidates = trigBySig[sig] & ~matched;                                     // Seuls les déclencheurs de cette signature non encore vérifiés
+        for (k = 0; candidates; k++) {
+            bit = 1 << k;
+            if (!(candidates & bit)) continue;
+            candidates &= ~bit;
+            trigger = &triggers[k];
+            if ((bloc->pixX < trigger->pixX0) || (bloc->pixX > trigger->pixX1) || (bloc->pixY < trigger->pixY0) || (bloc->pixY > trigger->pixY1)) continue;
+            area = (lWord) bloc->pixWidth * bloc->pixHeight;
+            if ((area < trigger->pixMinArea) || ((trigger->pixMaxArea != 0) && (area > trigger->pixMaxArea))) continue;
+            matched |= bit;
+        }
+    }
+    pixy2_updateTriggers (mask, matched);
+}
+
+static long pixy2_orient (long ax, long ay, long bx, long by, long cx, long cy)
+{
+    long    d = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);                      // Signe du produit vectoriel AB x AC
+
+    return (d > 0) - (d < 0);
+}
+
+void PIXY2::pixy2_evalVectorTriggers (void){
+    Byte            matched = 0, bit;
+    int             i, k;
+    T_pixy2Vector   *v;
+    T_pixy2Trigger  *t;
+
+    for (k = 0; k < PIXY2_MAX_TRIGGERS; k++) {
+        bit = 1 << k;
+        if (!(trigVectors & bit)) continue;
+        t = &triggers[k];
+        for (i = 0; i < Pixy2_numVectors; i++) {                                    // Le vecteur et la ligne se coupent si chacun sépare les extrémités de l'autre
+            v = &Pixy2_vectors[i];
+            if ((pixy2_orient (t->pixX0, t->pixY0, t->pixX1, t->pixY1, v->pixX0, v->pixY0) * pixy2_orient (t->pixX0, t->pixY0, t->pixX1, t->pixY1, v->pixX1, v->pixY1) <= 0) &&
+                (pixy2_orient (v->pixX0, v->pixY0, v->pixX1, v->pixY1, t->pixX0, t->pixY0) * pixy2_orient (v->pixX0, v->pixY0, v->pixX1, v->pixY1, t->pixX1, t->pixY1) <= 0)) {
+                matched |= bit;
+                break;
+            }
+        }
+    }
+    pixy2_updateTriggers (trigVectors, matched);
+}
+
+void PIXY2::pixy2_log (Byte level, Byte event, Word a0, Word a1, Word a2){
+    core_util_critical_section_enter();                                             // Deux écrivains possibles : le thread de la liaison et celui des traitements différés
+    if (!pixy2_logWrite (logRing, &logHead, &logTail, level, event, a0, a1, a2)) Pixy2_logLost++;   // Anneau plein : on perd l'enregistrement le plus récent
+    core_util_critical_section_exit();
+}
+
+PIXY2::Byte PIXY2::pixy2_logWrite (T_pixy2LogRecord *ring, volatile uint16_t *head, const volatile uint16_t *tail, Byte level, Byte event, Word a0, Word a1, Word a2){
+    Word    h = core_util_atomic_load_u16 (head);
+    T_pixy2LogRecord    *record;
+
+    if ((Word)(h - core_util_atomic_load_u16 (tail)) >= PIXY2_LOG_SIZE) return 0;
+    record = &ring[h & (PIXY2_LOG_SIZE - 1)];                                       // Aucune mise en forme ici : juste l'identifiant et les arguments
+    record->logTime = us_ticker_read();
+    record->logEvent = event;
+    record->logLevel = level;
+    record->logArg[0] = a0;
+    record->logArg[1] = a1;
+    record->logArg[2] = a2;
+    core_util_atomic_store_u16 (head, h + 1);                                       // Publication (après l'écriture complète de l'enregistrement)
+    return 1;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_readLog (T_pixy2LogRecord *record){
+    Word    tail = core_util_atomic_load_u16 (&logTail);
+
+    if (tail == core_util_atomic_load_u16 (&logHead)) return PIXY2_MISC_ERROR;      // Anneau vide
+    *record = logRing[tail & (PIXY2_LOG_SIZE - 1)];
+    core_util_atomic_store_u16 (&logTail, tail + 1);                                // On libère la case (après la copie)
+    return PIXY2_OK;
+}
+
+int PIXY2::pixy2_formatLog (const T_pixy2LogRecord *record, char *text, int size){
+    int     n;
+
+    if (record->logEvent >= PIXY2_EVT_NUMBER || record->logLevel > PIXY2_LOG_DEBUG) return snprintf (text, size, "%lu us : unknown event %u", record->logTime, record->logEvent);
+    n = snprintf (text, size, "%lu us [%c] ", record->logTime, pixy2_logLevel[record->logLevel]);
+    if ((n < 0) || (n >= size)) return n;
+    if (record->logEvent == PIXY2_EVT_CAM_ERROR)                                    // Seul argument signé
+        return n + snprintf (text + n, size - n, pixy2_logFormat[record->logEvent], (sWord) record->logArg[0], record->logArg[1]);
+    return n + snprintf (text + n, size - n, pixy2_logFormat[record->logEvent], record->logArg[0], record->logArg[1], record->logArg[2]);
+}
+
+PIXY2::lWord PIXY2::pixy2_measureLog (Word count){
+    T_pixy2LogRecord    scratch[PIXY2_LOG_SIZE];                                    // Anneau de mesure : le journal réel n'est pas touché
+    volatile uint16_t   head = 0, tail = 0;
+    lWord               start, duration;
+    Word                i;
+
+    if (count == 0) return 0;
+    start = us_ticker_read();
+    for (i = 0; i < count; i++) {
+        if ((i & (PIXY2_LOG_SIZE - 1)) == 0) core_util_atomic_store_u16 (&tail, head);   // On vide l'anneau avant qu'il soit plein : seul le chemin d'écriture est mesuré
+        pixy2_logWrite (scratch, &head, &tail, PIXY2_LOG_DEBUG, PIXY2_EVT_MEASURE, i + 1, count, 0);
+    }
+    duration = us_ticker_read() - start;
+    return (lWord) (((unsigned long long) duration * 1000) / count);                // En nano-secondes par enregistrement (64 bits : pas de débordement au-delà de 4,3 s)
+}
+
+static PIXY2::Byte* pixy2_putVarint (PIXY2::Byte *p, PIXY2::lWord value)
+{
+    while (value >= 0x80) {                                                         // 7 bits par octet, bit 7 = il reste des octets
+        *p++ = (PIXY2::Byte) (value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (PIXY2::Byte) value;
+    return p;
+}
+
+static PIXY2::Byte* pixy2_putDelta (PIXY2::Byte *p, long value, long reference)
+{
+    long    delta = value - reference;
+
+    return pixy2_putVarint (p, (delta < 0) ? ((PIXY2::lWord) (-delta) << 1) - 1 : (PIXY2::lWord) delta << 1);   // Zigzag : les petites valeurs négatives restent courtes
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setRecorder (Byte enable){
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;        // Un thread de traitement différé utilise le buffer (voir pixy2_setDeferred)
+    if (enable && (recBuffer == NULL)) {
+        recBuffer = (Byte*) pixy2_alloc (2 * PIXY2_REC_SECTOR);
+        if (recBuffer != NULL) {
+            recSector = 0;
+            recCurrent = 0;
+            pixy2_startSector();
+        } else cr = PIXY2_MISC_ERROR;
+    }
+    if (cr == PIXY2_OK) recEnable = enable;
+    core_util_atomic_flag_clear (&deferBusy);
+    return cr;
+}
+
+void PIXY2::pixy2_startSector (void){
+    Byte    *p = &recBuffer[recCurrent * PIXY2_REC_SECTOR];
+
+    p[0] = PIXY2_REC_MAGIC;                                                         // Entête de secteur
+    p[1] = PIXY2_REC_VERSION;
+    p[2] = recSector & 0xFF;
+    p[3] = recSector >> 8;
+    recFill = 4;
+    recNumPrev = 0;                                                                 // Chaque secteur est décodable seul : pas de référence
+}
+
+void PIXY2::pixy2_recordBlocks (void){
+    Byte    frame[12 + 8 * 3 * PIXY2_MAX_BLOCS];                                    // Pire cas : 3 octets par champ
+    Byte    *p = frame;
+    lWord   now = us_ticker_read();
+    int     i, n = Pixy2_numBlocks, size;
+    const T_pixy2Bloc   *ref, zero = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    if (n > PIXY2_MAX_BLOCS) n = PIXY2_MAX_BLOCS;
+    if (recFill + 5 + 1 + 8 * 3 * n + 1 > PIXY2_REC_SECTOR) {                       // La trame pourrait ne pas tenir : on change de secteur
+        if (pixy2_closeSector() != PIXY2_OK) {                                      // Le thread d'écriture est en retard : on perd la trame
+            Pixy2_recLost++;
+            return;
+        }
+    }
+    p = pixy2_putVarint (p, n + 1);
+    p = pixy2_putVarint (p, (recFill == 4) ? now : now - recTime);                  // Temps absolu en début de secteur, écart ensuite
+    for (i = 0; i < n; i++) {
+        ref = (i < recNumPrev) ? &recPrev[i] : &zero;                               // Différence avec le même bloc de la trame précédente
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixSignature, ref->pixSignature);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixX, ref->pixX);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixY, ref->pixY);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixWidth, ref->pixWidth);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixHeight, ref->pixHeight);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixAngle, ref->pixAngle);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixIndex, ref->pixIndex);
+        p = pixy2_putDelta (p, Pixy2_blocks[i].pixAge, ref->pixAge);
+    }
+    size = p - frame;
+    memcpy (&recBuffer[recCurrent * PIXY2_REC_SECTOR + recFill], frame, size);
+    recFill += size;
+    for (i = 0; i < n; i++) recPrev[i] = Pixy2_blocks[i];
+    recNumPrev = n;
+    recTime = now;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getSector (const Byte **sector){
+    int     i;
+
+    if (recBuffer == NULL) return PIXY2_MISC_ERROR;
+    for (i = 0; i < 2; i++) {                                                       // Au plus un secteur plein à la fois
+        if (core_util_atomic_load_u8 (&recFull[i])) {
+            *sector = &recBuffer[i * PIXY2_REC_SECTOR];
+            return PIXY2_OK;
+        }
+    }
+    return PIXY2_BUSY;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_releaseSector (void){
+    if (recBuffer == NULL) return PIXY2_MISC_ERROR;
+    if (core_util_atomic_load_u8 (&recFull[0])) core_util_atomic_store_u8 (&recFull[0], 0);
+    else core_util_atomic_store_u8 (&recFull[1], 0);
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_flushRecorder (void){
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (recBuffer == NULL) return PIXY2_MISC_ERROR;
+    if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;        // Un thread de traitement différé remplit le secteur (voir pixy2_setDeferred)
+    if (recFill != 4) cr = pixy2_closeSector();                                     // Rien à écrire si le secteur est vide
+    core_util_atomic_flag_clear (&deferBusy);
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_closeSector (void){
+    if (core_util_atomic_load_u8 (&recFull[recCurrent ^ 1])) return PIXY2_BUSY;    // L'autre secteur n'est pas encore écrit
+    memset (&recBuffer[recCurrent * PIXY2_REC_SECTOR + recFill], 0, PIXY2_REC_SECTOR - recFill);    // Fin de secteur (0)
+    core_util_atomic_store_u8 (&recFull[recCurrent], 1);                            // Le secteur est publié pour le thread d'écriture
+    recCurrent ^= 1;
+    recSector++;
+    pixy2_startSector();
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setCoalescing (lWord window){
+    coalesceWindow = window;
+    coalesceValid = 0;
+    return PIXY2_OK;
+}
+
+PIXY2::Byte PIXY2::pixy2_coalesce (lWord key, Byte (*filter)(const T_pixy2Bloc*), T_pixy2ErrorCode *cr){
+    if (!coalesceValid || (key != coalesceKey) || (filter != coalesceFilter)) return 0;
+    if ((lWord) (us_ticker_read() - coalesceTime) > coalesceWindow) {              // Résultats trop anciens : une nouvelle trame est sans doute disponible
+        coalesceValid = 0;
+        return 0;
+    }
+    Pixy2_coalesced++;
+    *cr = coalesceResult;
+    return 1;
+}
+
+void PIXY2::pixy2_coalesceStore (Byte (*filter)(const T_pixy2Bloc*), T_pixy2ErrorCode cr){
+    if ((coalesceWindow == 0) || (cr < PIXY2_OK)) return;
+    coalesceKey = coalescePending;                                                  // Requête à laquelle répondent les résultats
+    coalesceFilter = filter;
+    coalesceResult = cr;
+    coalesceTime = us_ticker_read();
+    coalesceValid = 1;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setPublisher (Byte enable){
+    int                 i;
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;        // Un thread de traitement différé utilise le buffer (voir pixy2_setDeferred)
+    if (!enable) {
+        free (pubFrames);
+        pubFrames = NULL;
+    } else if (pubFrames == NULL) {
+        pubFrames = (T_pixy2Frame*) pixy2_alloc (PIXY2_PUB_SLOTS * sizeof (T_pixy2Frame));
+        if (pubFrames != NULL) {
+            for (i = 0; i < PIXY2_PUB_SLOTS; i++) pubFrames[i].pixSequence = 0;     // Aucune trame publiée
+        } else cr = PIXY2_MISC_ERROR;
+    }
+    core_util_atomic_flag_clear (&deferBusy);
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_attachPublisher (Callback<void(uint32_t)> function){
+    pubCallback = function;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_publishBlocks (void){
+    uint32_t        sequence = core_util_atomic_load_u32 (&pubLast) + 1;
+    T_pixy2Frame    *frame = &pubFrames[sequence % PIXY2_PUB_SLOTS];
+    int             n = Pixy2_numBlocks;
+
+    if (n > PIXY2_MAX_BLOCS) n = PIXY2_MAX_BLOCS;
+    core_util_atomic_store_u32 (&frame->pixSequence, 0);                            // Case en cours d'écriture : les lecteurs la voient invalide
+    __DMB();                                                                        // Le 0 est visible avant toute écriture de la trame
+    frame->pixRxTime = rxTime;
+    frame->pixNumBlocks = n;
+    memcpy (frame->pixBlocks, Pixy2_blocks, n * sizeof (T_pixy2Bloc));             // Seule copie : le buffer de réception sera écrasé par la requête suivante
+    frame->pixPublishTime = us_ticker_read();
+    __DMB();                                                                        // Toute la trame est écrite avant son numéro de séquence
+    core_util_atomic_store_u32 (&frame->pixSequence, sequence);                     // Publication
+    core_util_atomic_store_u32 (&pubLast, sequence);
+    if (pubCallback) pubCallback (sequence);                                        // Réveil des lecteurs
+}
+
+uint32_t PIXY2::pixy2_lastFrame (void){
+    return core_util_atomic_load_u32 (&pubLast);
+}
+
+const PIXY2::T_pixy2Frame* PIXY2::pixy2_peekFrame (uint32_t sequence){
+    const T_pixy2Frame  *frame;
+
+    if ((pubFrames == NULL) || (sequence == 0)) return NULL;
+    frame = &pubFrames[sequence % PIXY2_PUB_SLOTS];
+    if (core_util_atomic_load_u32 (&frame->pixSequence) != sequence) return NULL;  // Lecture avec barrière : trame pas encore publiée ou déjà remplacée
+    return frame;
+}
+
+PIXY2::Byte PIXY2::pixy2_frameValid (const T_pixy2Frame *frame, uint32_t sequence){
+    __DMB();                                                                        // La lecture de la trame est terminée avant de relire le numéro de séquence
+    return core_util_atomic_load_u32 (&frame->pixSequence) == sequence;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setTimeout (lWord time){
+    timeout = time;
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_checkPending (void){
+    if ((timeout == 0) || ((lWord) (us_ticker_read() - sendTime) <= timeout)) return PIXY2_BUSY;
+    core_util_critical_section_enter();                                             // La réception ne doit pas avancer pendant qu'on abandonne la requête
+    etat = idle;                                                                    // La caméra ne répond plus : on abandonne la requête
+    wPointer = 0;
+    core_util_critical_section_exit();
+    linkStats.pixTimeouts++;
+    PIXY2_LOG (PIXY2_LOG_WARNING, PIXY2_EVT_TIMEOUT, coalescePending >> 16, 0, 0);
+    return pixy2_retry (PIXY2_FAIL_TIMEOUT, PIXY2_TIMEOUT);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getLinkStats (T_pixy2LinkStats *stats, Byte reset){
+    core_util_critical_section_enter();                                             // Copie cohérente (une partie des compteurs est mise à jour sous interruption)
+    *stats = linkStats;
+    if (reset) memset (&linkStats, 0, sizeof (linkStats));
+    core_util_critical_section_exit();
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setDeferred (Byte enable, Callback<void()> ready){
+    if (!enable) {
+        if (deferFrames == NULL) return PIXY2_OK;
+        if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;    // Un thread traite une trame : la file ne peut pas être libérée
+        Pixy2_deferLost += (uint8_t) (deferHead - deferTail);                       // Les trames en attente ne seront pas traitées
+        free (deferFrames);
+        deferFrames = NULL;
+        deferHead = deferTail = 0;
+        core_util_atomic_flag_clear (&deferBusy);
+        return PIXY2_OK;
+    }
+    deferReady = ready;
+    if (deferFrames != NULL) return PIXY2_OK;
+    deferFrames = (T_pixy2Frame*) pixy2_alloc (PIXY2_DEFER_FRAMES * sizeof (T_pixy2Frame));
+    if (deferFrames == NULL) return PIXY2_MISC_ERROR;
+    deferHead = deferTail = 0;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_deferBlocks (const T_pixy2Bloc *blocks, int num){
+    uint8_t         head = core_util_atomic_load_u8 (&deferHead);
+    T_pixy2Frame    *frame;
+
+    if ((uint8_t) (head - core_util_atomic_load_u8 (&deferTail)) >= PIXY2_DEFER_FRAMES) {  // Le thread de traitement est en retard : on perd la trame
+        Pixy2_deferLost++;
+        return;
+    }
+    frame = &deferFrames[head % PIXY2_DEFER_FRAMES];
+    if (num > PIXY2_MAX_BLOCS) num = PIXY2_MAX_BLOCS;
+    frame->pixSequence = head;
+    frame->pixRxTime = rxTime;
+    frame->pixNumBlocks = num;
+    memcpy (frame->pixBlocks, blocks, num * sizeof (T_pixy2Bloc));                  // Copie : le buffer de réception sera écrasé par la requête suivante
+    core_util_atomic_store_u8 (&deferHead, head + 1);                               // La trame est confiée au thread de traitement
+    if (deferReady) deferReady ();
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_processFrame (void){
+    uint8_t         tail;
+
+    do {
+        if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;    // Un autre thread traite déjà cette caméra : il videra la file
+        if (deferFrames == NULL) {                                                  // Vérifié sous le drapeau : la file ne peut pas être libérée pendant le traitement
+            core_util_atomic_flag_clear (&deferBusy);
+            return PIXY2_MISC_ERROR;
+        }
+        while ((tail = core_util_atomic_load_u8 (&deferTail)) != core_util_atomic_load_u8 (&deferHead)) {
+            Pixy2_blocks = deferFrames[tail % PIXY2_DEFER_FRAMES].pixBlocks;        // Les trames sont traitées dans l'ordre de réception
+            Pixy2_numBlocks = deferFrames[tail % PIXY2_DEFER_FRAMES].pixNumBlocks;
+            pixy2_processBlocks();
+            core_util_atomic_store_u8 (&deferTail, tail + 1);                       // On libère la case après le traitement (Pixy2_blocks pointe dessus)
+        }
+        core_util_atomic_flag_clear (&deferBusy);
+    } while (core_util_atomic_load_u8 (&deferTail) != core_util_atomic_load_u8 (&deferHead));  // Trame arrivée entre la fin de la boucle et la libération
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setServoRate (Word rate){
+    if (rate == 0) return PIXY2_MISC_ERROR;
+    servoPeriod = 1000000UL / rate;
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setTrajectory (Word s0, Word s1, Word speed, Word accel){
+    T_pixy2Waypoint target = {s0, s1};
+
+    return pixy2_setWaypoints (&target, 1, speed, accel);
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setWaypoints (const T_pixy2Waypoint *points, Byte num, Word speed, Word accel){
+    int     i;
+    lWord   now = us_ticker_read();
+    Word    from[2];
+
+    if ((num == 0) || (num > PIXY2_MAX_WAYPOINTS) || (speed == 0) || (accel == 0)) return PIXY2_MISC_ERROR;
+    for (i = 0; i < num; i++) {                                                     // Tous les points sont vérifiés avant de toucher à la trajectoire en cours
+        if ((points[i].pixS0 > 511) || (points[i].pixS1 > 511)) return PIXY2_MISC_ERROR;
+    }
+    if (Pixy2_trajectoryActive) pixy2_trajectoryPoint (now, &from[0], &from[1]);    // Nouvelle trajectoire en cours de mouvement : on part de la position actuelle (calculée sur l'ancienne table)
+    else if (servoPos[0] > 511) {                                                   // Position inconnue : on rejoint directement le premier point
+        from[0] = points[0].pixS0;
+        from[1] = points[0].pixS1;
+    } else {
+        from[0] = servoPos[0];
+        from[1] = servoPos[1];
+    }
+    for (i = 0; i < num; i++) trajPoints[i] = points[i];
+    trajFrom[0] = from[0];
+    trajFrom[1] = from[1];
+    trajNum = num;
+    trajIndex = 0;
+    trajSpeed = speed;
+    trajAccel = accel;
+    trajStart = now;
+    pixy2_segmentTime();
+    servoLast = now - servoPeriod;                                                  // Première mise à jour dès que la liaison est libre
+    Pixy2_trajectoryActive = 1;
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_stopTrajectory (void){
+    if (Pixy2_trajectoryActive) pixy2_trajectoryPoint (us_ticker_read(), &servoPos[0], &servoPos[1]);
+    Pixy2_trajectoryActive = 0;
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_segmentTime (void){
+    float   dx = (float) trajPoints[trajIndex].pixS0 - trajFrom[0];
+    float   dy = (float) trajPoints[trajIndex].pixS1 - trajFrom[1];
+    float   d = sqrtf (dx * dx + dy * dy);
+    float   tAcc = (float) trajSpeed / trajAccel;                                   // Durée de la phase d'accélération (profil trapézoïdal)
+
+    trajLength = d;
+    if (d < (float) trajSpeed * tAcc) {                                             // Profil triangulaire : la vitesse maximale n'est pas atteinte
+        tAcc = sqrtf (d / trajAccel);
+        trajPeak = trajAccel * tAcc;
+        trajDuration = 2.0f * tAcc;
+    } else {
+        trajPeak = trajSpeed;
+        trajDuration = tAcc + d / trajSpeed;
+    }
+}
+
+void PIXY2::pixy2_trajectoryPoint (lWord now, Word *s0, Word *s1){
+    float   t = (lWord) (now - trajStart) * 1e-6f;                                  // Temps écoulé depuis le début du segment (en secondes)
+    float   tAcc, s, ratio;
+
+    while (t >= trajDuration) {                                                     // Segment terminé : on passe au point suivant
+        t -= trajDuration;
+        trajStart += (lWord) (trajDuration * 1e6f);
+        trajFrom[0] = trajPoints[trajIndex].pixS0;
+        trajFrom[1] = trajPoints[trajIndex].pixS1;
+        if (++trajIndex >= trajNum) {                                               // Dernier point atteint
+            *s0 = trajFrom[0];
+            *s1 = trajFrom[1];
+            Pixy2_trajectoryActive = 0;
+            return;
+        }
+        pixy2_segmentTime();
+    }
+    tAcc = trajPeak / trajAccel;
+    if (t < tAcc) s = 0.5f * trajAccel * t * t;                                     // Accélération
+    else if (t < trajDuration - tAcc) s = 0.5f * trajPeak * tAcc + trajPeak * (t - tAcc);  // Vitesse constante
+    else s = trajLength - 0.5f * trajAccel * (trajDuration - t) * (trajDuration - t);      // Décélération
+    ratio = (trajLength > 0.0f) ? s / trajLength : 1.0f;
+    *s0 = (Word) (trajFrom[0] + ratio * ((float) trajPoints[trajIndex].pixS0 - trajFrom[0]) + 0.5f);
+    *s1 = (Word) (trajFrom[1] + ratio * ((float) trajPoints[trajIndex].pixS1 - trajFrom[1]) + 0.5f);
+}
+
+PIXY2::Byte PIXY2::pixy2_streamServos (void){
+    Word    s0, s1;
+    lWord   now;
+
+    if (streamOwned) {                                                              // La liaison est occupée par une mise à jour des servos
+        if (etat == dataReceived) {                                                 // On consomme l'acquittement (rien à rendre à l'utilisateur)
+            streamOwned = 0;
+            etat = idle;
+            return 0;
+        }
+        if (etat == idle) {                                                         // Réponse sans données
+            streamOwned = 0;
+            return 0;
+        }
+        if (pixy2_checkPending() == PIXY2_TIMEOUT) {                                // La caméra n'a pas répondu : on rend la liaison
+            streamOwned = 0;
+            return 0;
+        }
+        return 1;
+    }
+    if (!Pixy2_trajectoryActive || (etat != idle)) return 0;
+    now = us_ticker_read();
+    if ((lWord) (now - servoLast) < servoPeriod) return 0;                          // Pas encore l'heure de la prochaine mise à jour
+    pixy2_trajectoryPoint (now, &s0, &s1);                                          // Position calculée au moment de l'envoi : une mise à jour en retard ne s'accumule pas
+    servoLast = now;
+    if ((s0 == servoPos[0]) && (s1 == servoPos[1])) return 0;                       // Rien n'a bougé
+    wPointer = 0;
+    streamOwned = 1;                                                                // Avant l'envoi : la requête du driver ne touche pas aux nouveaux essais de l'utilisateur
+    if (pixy2_sndSetServo (s0, s1) != PIXY2_OK) {
+        streamOwned = 0;
+        return 0;
+    }
+    servoPos[0] = s0;
+    servoPos[1] = s1;
+    etat = messageSent;
+    return 1;
+}
+
+PIXY2::Byte PIXY2::pixy2_commandClass (Byte type){
+    switch (type) {
+        case PIXY2_ASK_BLOC :
+        case PIXY2_ASK_LINE :
+            return PIXY2_CLASS_DETECT;
+        case PIXY2_SET_SERVOS :
+        case PIXY2_SET_LED :
+        case PIXY2_SET_LAMP :
+            return PIXY2_CLASS_ACTUATOR;
+        case PIXY2_SET_BRIGHT :
+        case PIXY2_SET_MODE :
+        case PIXY2_SET_TURN :
+        case PIXY2_SET_DEFTURN :
+        case PIXY2_SET_VECTOR :
+        case PIXY2_SET_REVERSE :
+            return PIXY2_CLASS_CONFIG;
+        default :                                                                   // Version, résolution, FPS, couleur d'un pixel
+            return PIXY2_CLASS_QUERY;
+    }
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setRateLimit (Byte cmdClass, Byte unit, Word rate, Word burst){
+    if ((cmdClass >= PIXY2_CLASSES) || (unit > PIXY2_RATE_BYTES) || (rate && !burst)) return PIXY2_MISC_ERROR;
+    buckets[cmdClass].rate = 0;                                                     // Pas de limitation pendant la mise à jour
+    buckets[cmdClass].unit = unit;
+    buckets[cmdClass].burst = (lWord) burst * 1000;
+    buckets[cmdClass].tokens = buckets[cmdClass].burst;                             // Le seau démarre plein
+    buckets[cmdClass].last = us_ticker_read();
+    buckets[cmdClass].rate = rate;
+    return PIXY2_OK;
+}
+
+PIXY2::Byte PIXY2::pixy2_takeToken (Byte cmdClass, int size){
+    T_pixy2Bucket       *bucket = &buckets[cmdClass];
+    lWord               now, elapsed, cost;
+    unsigned long long  tokens;
+
+    if (bucket->rate == 0) return 1;                                                // Classe non limitée
+    now = us_ticker_read();
+    elapsed = now - bucket->last;
+    bucket->last = now;
+    tokens = bucket->tokens + ((unsigned long long) elapsed * bucket->rate) / 1000; // Jetons en millièmes : rate par seconde = rate / 1000 par micro-seconde (calcul en 64 bits, sans débordement)
+    bucket->tokens = (tokens > bucket->burst) ? bucket->burst : (lWord) tokens;     // Saturation avant de revenir en 32 bits
+    cost = (bucket->unit == PIXY2_RATE_BYTES) ? (lWord) size * 1000 : 1000;
+    if (bucket->tokens < cost) return 0;
+    bucket->tokens -= cost;
+    return 1;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setStats (Byte enable, Word window, Word threshold){
+    T_pixy2ErrorCode    cr = PIXY2_OK;
+
+    if (enable && (window == 0)) return PIXY2_MISC_ERROR;
+    if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;        // Un thread de traitement différé utilise le buffer (voir pixy2_setDeferred)
+    if (!enable) {
+        free (sigStats);
+        sigStats = NULL;
+    } else {
+        if (sigStats == NULL) sigStats = (T_pixy2StatsState*) pixy2_alloc (sizeof (T_pixy2StatsState));
+        if (sigStats != NULL) {
+            memset (sigStats, 0, sizeof (T_pixy2StatsState));                      // Nouvelle fenêtre, pas encore de référence
+            statsWindow = window;
+            statsThreshold = threshold;
+            Pixy2_statsAlert = 0;
+        } else cr = PIXY2_MISC_ERROR;
+    }
+    core_util_atomic_flag_clear (&deferBusy);
+    return cr;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getStats (Byte slot, T_pixy2SigStats *stats){
+    if ((sigStats == NULL) || (slot >= PIXY2_STATS_SLOTS) || !sigStats->windows) return PIXY2_MISC_ERROR;
+    *stats = sigStats->last[slot];
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setStatsReference (void){
+    if ((sigStats == NULL) || !sigStats->windows) return PIXY2_MISC_ERROR;
+    if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;        // Un thread de traitement différé utilise le buffer (voir pixy2_setDeferred)
+    memcpy (sigStats->reference, sigStats->last, sizeof (sigStats->last));          // La dernière fenêtre devient la référence (après recalibration)
+    Pixy2_statsAlert = 0;
+    core_util_atomic_flag_clear (&deferBusy);
+    return PIXY2_OK;
+}
+
+void PIXY2::pixy2_updateStats (void){
+    T_pixy2StatsAcc *acc;
+    int             i, k, bin;
+    long long       value[4], n, num;
+
+    for (i = 0; i < Pixy2_numBlocks; i++) {
+        acc = &sigStats->acc[(Pixy2_blocks[i].pixSignature <= 7) ? Pixy2_blocks[i].pixSignature : PIXY2_STATS_CC];
+        value[0] = Pixy2_blocks[i].pixX;
+        value[1] = Pixy2_blocks[i].pixY;
+        value[2] = Pixy2_blocks[i].pixWidth;
+        value[3] = Pixy2_blocks[i].pixHeight;
+        acc->count++;
+        for (k = 0; k < 4; k++) {                                                   // Sommes entières exactes : aucune perte de précision, même sur une longue fenêtre
+            acc->sum[k] += value[k];
+            acc->sumSq[k] += value[k] * value[k];
+        }
+        if (Pixy2_blocks[i].pixSignature > 7) {                                     // Codes couleur : histogramme des angles
+            bin = ((int) Pixy2_blocks[i].pixAngle + 180) * PIXY2_ANGLE_BINS / 360;
+            if (bin < 0) bin = 0;
+            if (bin >= PIXY2_ANGLE_BINS) bin = PIXY2_ANGLE_BINS - 1;
+            if (acc->angles[bin] < 0xFFFF) acc->angles[bin]++;
+        }
+    }
+    if (++sigStats->frames < statsWindow) return;
+    sigStats->frames = 0;                                                           // Fin de fenêtre : instantané, comparaison à la référence et remise à zéro
+    for (i = 0; i < PIXY2_STATS_SLOTS; i++) {
+        acc = &sigStats->acc[i];
+        sigStats->last[i].pixCount = acc->count;
+        n = acc->count;
+        for (k = 0; k < 4; k++) {
+            sigStats->last[i].pixMean[k] = (n > 0) ? (slWord) (((acc->sum[k] << 8) + n / 2) / n) : 0;   // Q8 arrondi
+            if (n > 1) {
+                num = n * acc->sumSq[k] - acc->sum[k] * acc->sum[k];                // n² fois la variance de la population (exact)
+                sigStats->last[i].pixVariance[k] = (lWord) ((((num / n) << 8) + ((num % n) << 8) / n) / (n - 1));   // Q8 : num x 256 / (n (n - 1)) sans débordement
+            } else sigStats->last[i].pixVariance[k] = 0;
+        }
+        memcpy (sigStats->last[i].pixAngles, acc->angles, sizeof (acc->angles));
+        if (sigStats->windows && pixy2_statsShift (&sigStats->last[i], &sigStats->reference[i])) Pixy2_statsAlert |= 1 << i;
+        memset (acc, 0, sizeof (T_pixy2StatsAcc));
+    }
+    if (!sigStats->windows) memcpy (sigStats->reference, sigStats->last, sizeof (sigStats->last));  // La première fenêtre sert de référence
+    sigStats->windows++;
+}
+
+PIXY2::Byte PIXY2::pixy2_statsShift (const T_pixy2SigStats *window, const T_pixy2SigStats *reference){
+    int         k;
+    long long   delta;
+
+    if ((statsThreshold == 0) || (window->pixCount < 2) || (reference->pixCount < 2)) return 0;
+    for (k = 0; k < 4; k++) {                                                       // Écart des moyennes comparé à l'écart-type de référence : (d / sigma)² > (seuil / 10)²
+        delta = (long long) window->pixMean[k] - reference->pixMean[k];             // Q8
+        if (delta * delta * 100 > (long long) statsThreshold * statsThreshold * ((long long) reference->pixVariance[k] << 8) + 100 * 256 * 256) return 1;   // Au moins un pixel d'écart
+    }
+    return 0;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_readResult (void){
+    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
+    Byte                *payload = &Pixy2_buffer[dPointer];
+    slWord              code;
+    Byte                action = PIXY2_POLICY_REPORT;
+
+    switch (msg->pixLength) {                                                       // La taille du code dépend de la réponse : on ne lit que ce qui a été reçu
+        case 0 :
+            code = (msg->pixType == PIXY2_REP_ERROR) ? PIXY2_MISC_ERROR : PIXY2_OK;
+            break;
+        case 1 :
+            code = (sByte) payload[0];
+            break;
+        case 2 :
+        case 3 :
+            code = (sWord) (payload[0] | (payload[1] << 8));
+            break;
+        default :
+            code = (slWord) (int32_t) ((lWord) payload[0] | ((lWord) payload[1] << 8) | ((lWord) payload[2] << 16) | ((lWord) payload[3] << 24));
+            break;
+    }
+    if (msg->pixType != PIXY2_REP_ERROR) return code;                               // Acquittement : résultat de la commande
+    Pixy2_lastError.pixCode = code;
+    Pixy2_lastError.pixRequest = coalescePending >> 16;                             // Type de la dernière requête envoyée
+    Pixy2_lastError.pixLength = msg->pixLength;
+    Pixy2_lastError.pixTime = rxTime;
+    linkStats.pixCameraErrors[((code < 0) && (code > -PIXY2_CAM_ERRORS)) ? -code : 0]++;
+    PIXY2_LOG (PIXY2_LOG_WARNING, PIXY2_EVT_CAM_ERROR, (Word) code, msg->pixLength, 0);
+    if (code == PIXY2_PROG_CHANGE) resolutionValid = 0;                             // Le nouveau programme n'a peut-être pas la même résolution
+    if (errorPolicy) action = errorPolicy (&Pixy2_lastError);
+    switch (action) {
+        case PIXY2_POLICY_RETRY :                                                   // L'appel suivant renverra la requête
+            return PIXY2_BUSY;
+        case PIXY2_POLICY_BACKOFF :                                                 // Plus de requête pendant le délai
+            errorHoldStart = us_ticker_read();
+            errorHold = 1;
+            return PIXY2_BUSY;
+        case PIXY2_POLICY_REINIT :                                                  // La caméra a peut-être redémarré : on oublie ce qu'on en savait
+            resolutionValid = 0;
+            versionValid = 0;
+            Pixy2_capabilities = PIXY2_CAP_ALL;
+            break;
+        default :
+            break;
+    }
+    return code;
+}
+
+void PIXY2::pixy2_setResolution (const T_pixy2Resolution *res){
+    resolution = *res;
+    resolutionValid = (res->pixFrameWidth != 0) && (res->pixFrameHeight != 0);
+    if (resolutionValid) {                                                          // Inverses en Q16 (arrondis au-dessus) : la normalisation n'est plus qu'une multiplication
+        normScale[PIXY2_GRID_BLOCS][0] = (((lWord) PIXY2_NORM_ONE << 16) + res->pixFrameWidth - 1) / res->pixFrameWidth;
+        normScale[PIXY2_GRID_BLOCS][1] = (((lWord) PIXY2_NORM_ONE << 16) + res->pixFrameHeight - 1) / res->pixFrameHeight;
+    }
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_invalidateResolution (void){
+    resolutionValid = 0;
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setNormalised (Byte enable){
+    if (core_util_atomic_flag_test_and_set (&deferBusy)) return PIXY2_BUSY;        // Un thread de traitement différé utilise le buffer (voir pixy2_setDeferred)
+    if (!enable) {
+        free (normBuffer);
+        normBuffer = NULL;
+        Pixy2_numNormBlocks = 0;
+        core_util_atomic_flag_clear (&deferBusy);
+        return PIXY2_OK;
+    }
+    if (normBuffer == NULL) {
+        normBuffer = (Byte*) pixy2_alloc (PIXY2_MAX_BLOCS * sizeof (T_pixy2Bloc) + PIXY2_MAX_VECTORS * sizeof (T_pixy2NormVector) + PIXY2_MAX_INTERS * sizeof (T_pixy2NormPoint));
+        if (normBuffer == NULL) {
+            core_util_atomic_flag_clear (&deferBusy);
+            return PIXY2_MISC_ERROR;
+        }
+    }
+    Pixy2_normBlocks = (T_pixy2Bloc*) normBuffer;
+    Pixy2_normVectors = (T_pixy2NormVector*) (normBuffer + PIXY2_MAX_BLOCS * sizeof (T_pixy2Bloc));
+    Pixy2_normIntersections = (T_pixy2NormPoint*) (normBuffer + PIXY2_MAX_BLOCS * sizeof (T_pixy2Bloc) + PIXY2_MAX_VECTORS * sizeof (T_pixy2NormVector));
+    Pixy2_numNormBlocks = 0;
+    normScale[PIXY2_GRID_LINE][0] = (((lWord) PIXY2_NORM_ONE << 16) + PIXY2_LINE_WIDTH - 1) / PIXY2_LINE_WIDTH;
+    normScale[PIXY2_GRID_LINE][1] = (((lWord) PIXY2_NORM_ONE << 16) + PIXY2_LINE_HEIGHT - 1) / PIXY2_LINE_HEIGHT;
+    core_util_atomic_flag_clear (&deferBusy);
+    return PIXY2_OK;
+}
+
+PIXY2::Word PIXY2::pixy2_normalise (Word v, Word size, lWord scale){
+    if (v > size) v = size;                                                         // Pas de débordement du produit en 32 bits
+    return (Word) (((lWord) v * scale) >> 16);
+}
+
+void PIXY2::pixy2_normaliseBlocks (void){
+    Word                w = resolution.pixFrameWidth, h = resolution.pixFrameHeight;
+    lWord               sx = normScale[PIXY2_GRID_BLOCS][0], sy = normScale[PIXY2_GRID_BLOCS][1];
+    T_pixy2Bloc         *n = Pixy2_normBlocks;
+    int                 i;
+
+    if (!resolutionValid) {                                                         // Résolution inconnue (voir pixy2_getResolution)
+        Pixy2_numNormBlocks = 0;
+        return;
+    }
+    for (i = 0; i < Pixy2_numBlocks; i++) {                                         // Toute la trame en une passe
+        n[i] = Pixy2_blocks[i];
+        n[i].pixX = pixy2_normalise (n[i].pixX, w, sx);
+        n[i].pixY = pixy2_normalise (n[i].pixY, h, sy);
+        n[i].pixWidth = pixy2_normalise (n[i].pixWidth, w, sx);
+        n[i].pixHeight = pixy2_normalise (n[i].pixHeight, h, sy);
+    }
+    Pixy2_numNormBlocks = Pixy2_numBlocks;
+}
+
+void PIXY2::pixy2_normaliseFeatures (Byte features){
+    lWord               sx = normScale[PIXY2_GRID_LINE][0], sy = normScale[PIXY2_GRID_LINE][1];
+    int                 i;
+
+    for (i = 0; (features & PIXY2_VECTOR) && (i < Pixy2_numVectors); i++) {
+        Pixy2_normVectors[i].pixX0 = pixy2_normalise (Pixy2_vectors[i].pixX0, PIXY2_LINE_WIDTH, sx);
+        Pixy2_normVectors[i].pixY0 = pixy2_normalise (Pixy2_vectors[i].pixY0, PIXY2_LINE_HEIGHT, sy);
+        Pixy2_normVectors[i].pixX1 = pixy2_normalise (Pixy2_vectors[i].pixX1, PIXY2_LINE_WIDTH, sx);
+        Pixy2_normVectors[i].pixY1 = pixy2_normalise (Pixy2_vectors[i].pixY1, PIXY2_LINE_HEIGHT, sy);
+        Pixy2_normVectors[i].pixIndex = Pixy2_vectors[i].pixIndex;
+        Pixy2_normVectors[i].pixFlags = Pixy2_vectors[i].pixFlags;
+    }
+    for (i = 0; (features & PIXY2_INTERSECTION) && (i < Pixy2_numIntersections); i++) {
+        Pixy2_normIntersections[i].pixX = pixy2_normalise (Pixy2_intersections[i].pixX, PIXY2_LINE_WIDTH, sx);
+        Pixy2_normIntersections[i].pixY = pixy2_normalise (Pixy2_intersections[i].pixY, PIXY2_LINE_HEIGHT, sy);
+    }
+}
+
+PIXY2::Byte PIXY2::pixy2_commandCapability (Byte type){
+    switch (type) {
+        case PIXY2_ASK_BLOC :
+            return PIXY2_CAP_BLOCS;
+        case PIXY2_ASK_LINE :
+        case PIXY2_SET_MODE :
+        case PIXY2_SET_TURN :
+        case PIXY2_SET_DEFTURN :
+        case PIXY2_SET_VECTOR :
+        case PIXY2_SET_REVERSE :
+            return PIXY2_CAP_LINE;
+        case PIXY2_ASK_VIDEO :
+            return PIXY2_CAP_VIDEO;
+        default :                                                                   // Version, résolution, FPS, luminosité, servos, LED et lampe
+            return PIXY2_CAP_GENERAL;
+    }
+}
+
+void PIXY2::pixy2_setVersion (const T_pixy2Version *ver){
+    Byte                caps = PIXY2_CAP_ALL;                                       // Tout ce qui n'est pas connu comme absent est supposé disponible
+    unsigned int        i;
+
+    version = *ver;
+    versionValid = 1;
+    for (i = 0; i < sizeof (pixy2_capVersion) / sizeof (pixy2_capVersion[0]); i++) {   // On ne retire une fonctionnalité que pour les builds documentés sans elle
+        if ((ver->pixFWVersionMaj == pixy2_capVersion[i].major) && (ver->pixFWVersionMin == pixy2_capVersion[i].minor) && (ver->pixFWBuild < pixy2_capVersion[i].build))
+            caps &= ~pixy2_capVersion[i].capability;
+    }
+    Pixy2_capabilities = caps;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setCapabilities (Byte capabilities){
+    Pixy2_capabilities = capabilities | PIXY2_CAP_GENERAL;                          // Les requêtes générales restent toujours permises
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setErrorPolicy (Callback<Byte(const T_pixy2CameraError*)> policy, lWord backoff){
+    errorPolicy = policy;
+    errorBackoff = backoff;
+    errorHold = 0;
+    return PIXY2_OK;
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_setRetryPolicy (Byte failure, Byte maxAttempts, lWord backoff, Byte idempotentOnly){
+    if (failure >= PIXY2_FAILURES) return PIXY2_MISC_ERROR;
+    retryRules[failure].maxAttempts = maxAttempts;
+    retryRules[failure].backoff = backoff;
+    retryRules[failure].idempotentOnly = idempotentOnly;
+    return PIXY2_OK;
+}
+
+PIXY2::Byte PIXY2::pixy2_idempotent (Byte type){
+    switch (type) {
+        case PIXY2_SET_TURN :                                                       // Consommé au prochain croisement
+        case PIXY2_SET_REVERSE :                                                    // Chaque envoi inverse le vecteur
+            return 0;
+        default :                                                                   // Requêtes et consignes absolues
+            return 1;
+    }
+}
+
+PIXY2::Byte PIXY2::pixy2_acceptReply (Byte type, T_pixy2ErrorCode *cr){
+    T_pixy2RcvHeader    *msg = (T_pixy2RcvHeader*) &Pixy2_buffer[hPointer];
+
+    if (frameContainChecksum && (pixy2_validateChecksum (&Pixy2_buffer[hPointer]) != 0)) {
+        *cr = pixy2_retry (PIXY2_FAIL_CHECKSUM, PIXY2_BAD_CHECKSUM);                // Si le checksum est faux : nouvel essai ou erreur
+        return 0;
+    }
+    if (msg->pixType == type) return 1;                                             // Trame du type convenable : décodée par l'appelant
+    if (msg->pixType == PIXY2_REP_ERROR) {                                          // Cela pourrait être une trame d'erreur
+        *cr = pixy2_readResult ();                                                  // Si c'est le cas, on renvoie le code d'erreur reçu
+    } else {                                                                        // Si le type ne correspond à rien de normal on signale une erreur de type.
+        PIXY2_LOG (PIXY2_LOG_ERROR, PIXY2_EVT_TYPE_ERROR, msg->pixType, msg->pixLength, 0);
+        linkStats.pixTypeErrors++;
+        *cr = pixy2_retry (PIXY2_FAIL_TYPE, PIXY2_TYPE_ERROR);
+    }
+    etat = idle;                                                                    // La réponse est consommée
+    return 0;
+}
+
+PIXY2::Byte PIXY2::pixy2_requestSlot (Byte type){
+    switch (type) {
+        case PIXY2_ASK_RESOL :      return 0;
+        case PIXY2_ASK_VERS :       return 1;
+        case PIXY2_SET_BRIGHT :     return 2;
+        case PIXY2_SET_SERVOS :     return 3;
+        case PIXY2_SET_LED :        return 4;
+        case PIXY2_SET_LAMP :       return 5;
+        case PIXY2_ASK_FPS :        return 6;
+        case PIXY2_ASK_BLOC :       return 7;
+        case PIXY2_ASK_LINE :       return 8;
+        case PIXY2_SET_MODE :       return 9;
+        case PIXY2_SET_VECTOR :     return 10;
+        case PIXY2_SET_TURN :       return 11;
+        case PIXY2_SET_DEFTURN :    return 12;
+        case PIXY2_SET_REVERSE :    return 13;
+        default :                   return 14;                                      // PIXY2_ASK_VIDEO
+    }
+}
+
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_retry (Byte failure, T_pixy2ErrorCode code){
+    T_pixy2RetryRule    *rule = &retryRules[failure];
+    Byte                type = coalescePending >> 16;                               // Type de la requête qui a échoué
+    T_pixy2RetryState   *retry = &retryState[pixy2_requestSlot (type)];
+
+    etat = idle;                                                                    // La réponse est consommée dans tous les cas
+    if (streamOwned) return code;                                                   // Mise à jour de trajectoire : la suivante partira à la prochaine période
+    if ((retry->count >= rule->maxAttempts) || (rule->idempotentOnly && !pixy2_idempotent (type))) {
+        if (retry->count > 0) linkStats.pixRetryFailures++;                         // Abandon après de nouveaux essais
+        retry->armed = 0;
+        retry->count = 0;
+        return code;
+    }
+    retry->count++;
+    retry->armed = 1;
+    retry->time = us_ticker_read();
+    retry->delay = rule->backoff << ((retry->count <= PIXY2_RETRY_SHIFT) ? retry->count - 1 : PIXY2_RETRY_SHIFT - 1);  // Délai doublé à chaque essai
+    return PIXY2_BUSY;                                                              // L'appel suivant renverra la requête
+}
+
+void* PIXY2::pixy2_alloc (size_t size){
+    void                *p = malloc (size);
+
+    if (p != NULL) {                                                                // Comptage des allocations (mesure du démarrage)
+        Pixy2_allocations++;
+        Pixy2_allocatedBytes += size;
+    }
+    return p;
+}
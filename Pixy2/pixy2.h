@@ -1,1071 +1,2824 @@
-/**
- * @file pixy2.h
- * @brief Header file containing the pixy2 class compatible with mbed-os 6 (baremetal or multithread) using UART interface with non blocking functions
- * @author Hugues Angelis - Théo Le Paih - Wael Hazami
- * @date March 2022
- *
- * @section LICENSE
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in
- * all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- * THE SOFTWARE.
- *
- * @section DESCRIPTION
- *
- * CMUCAM 5 - Pixy2 using UART interface (Serial)
- * 
- * Datasheet, FAQ and PC drivers :
- *
- * http://www.pixycam.com/
- * This library was written by H. Angelis and tested by T. Le Paih and W. Hazami
- */
-
-#ifndef _PIXY2_
-#define _PIXY2_
-
-/**
- * Include : Mbed Library
- */
-#include "mbed.h"
-
-/**
- * Defines
- */
-#define _DEBUG_ 1
-#define PIXY2_NCSHEADERSIZE 4
-#define PIXY2_CSHEADERSIZE  6
-#define PIXY2_SYNC          0xC1AE
-#define PIXY2_CSSYNC        0xC1AF
-#define PIXY2_REP_ACK       1
-#define PIXY2_REP_ERROR     3
-#define PIXY2_ASK_RESOL     12
-#define PIXY2_REP_RESOL     13
-#define PIXY2_ASK_VERS      14
-#define PIXY2_REP_VERS      15
-#define PIXY2_SET_BRIGHT    16
-#define PIXY2_SET_SERVOS    18
-#define PIXY2_SET_LED       20
-#define PIXY2_SET_LAMP      22
-#define PIXY2_ASK_FPS       24
-#define PIXY2_REP_FPS       1
-#define PIXY2_ASK_BLOC      32
-#define PIXY2_REP_BLOC      33
-#define PIXY2_ASK_LINE      48
-#define PIXY2_REP_LINE      49
-#define PIXY2_SET_MODE      54
-#define PIXY2_SET_TURN      58
-#define PIXY2_SET_VECTOR    56
-#define PIXY2_SET_DEFTURN   60
-#define PIXY2_SET_REVERSE   62
-#define PIXY2_ASK_VIDEO     112
-#define PIXY2_VECTOR        1
-#define PIXY2_INTERSECTION  2
-#define PIXY2_BARCODE       4
-#define PIXY2_MAX_INT_LINE  6
-
-// setMode
-#define LINE_MODE_TURN_DELAYED                   0x01
-#define LINE_MODE_MANUAL_SELECT_VECTOR           0x02
-#define LINE_MODE_WHITE_LINE                     0x80
-
-#define PIXY2_OK             0
-#define PIXY2_BUSY          -1
-#define PIXY2_MISC_ERROR    -2
-#define PIXY2_BAD_CHECKSUM  -3
-#define PIXY2_TIMEOUT       -4
-#define PIXY2_OVERRIDE      -5
-#define PIXY2_PROG_CHANGE   -6
-#define PIXY2_TYPE_ERROR    -7
-
-class PIXY2 {
-
-public :
-
-/**
- * \class PIXY2 pixy2.h
- * Pixy2 : CMU CAM 5 - Smart camera - Using UART interface - non blocking
- * \brief More informations at http://www.pixycam.com/
- * \note We use pointer to pointer in order to connect data received from UART and stored in a circular buffer, with structured objects (passed by address to the function)
- * of the class that point to the reception buffer. You don't have to allocate memory for those objects as they point directly into the reception buffer : see example below
- * \note Sending an order (ie : transmitting data to the camera is blocking), reception is non blocking
- * \note As all functions are non blocking (ie : they return immediately after sending the order) and as communication, and image processing at 30 FPS, may take some time 
- * you must wait for the function to complete its task before using the result or sending another order. When function return something else than PIXY2_BUSY then task has been processed.
- * The example program below shows how to communicate with Pixy2.
- *
- * \code
- * #include "mbed.h"
- * #include "Pixy2.h"
- * 
- * #define WAIT_TIME_MS 100ms 
- * DigitalOut led1(LED1);
- * PIXY2 cam (PIXY_TX, PIXY_RX, 230000);
- * 
- * int main()
- * {
- *     T_pixy2ErrorCode rCode;  // return Code
- *     T_pixy2Version *version; // Version for Pixy2 (no allocation needed)
- *     T_pixy2Bloc *bloc;       // Easy to use Color Code Bloc (not mandatory, no allocation needed)
- * 
- *     printf("\nPixy running on Mbed OS %d.%d.%d.\n", MBED_MAJOR_VERSION, MBED_MINOR_VERSION, MBED_PATCH_VERSION);
- * 
- *     printf("Playing with RGB LED : ");
- * 
- *     do {
- *         // switching on red led
- *         rCode = cam.pixy2_setLED (0xFF,0,0);
- *     } while (rCode == PIXY2_BUSY); // waiting for PIXY2 acknowledge (ie : order processed)
- *
- *     // here you may check if return code indicate an erroneous response
- *
- *     ThisThread::sleep_for(500ms);  // to allow visual detection 
- * 
- *     do {
- *         // Switching off red led
- *         rCode = cam.pixy2_setLED (0,0,0);
- *     } while (rCode == PIXY2_BUSY); // waiting for acknowledge (ie : order processed)
- *
- *     // here you may check if return code indicate an erroneous response
- *
- *     printf("done\n");
- * 
- *     printf("Reading Version : ");
- *     do {
- *         // Asking for Pixy2 Version
- *         rCode = cam.pixy2_getVersion (&version); //address of "version" will be somewhere in the reception buffer
- *     } while (rCode == PIXY2_BUSY); // waiting for acknowledge (ie : order processed)
- *
- *     // here you may check if return code indicate an erroneous response
- *
- *     printf("done\n");
- * 
- *     printf("Pixy : %s (HW : %d) - FW : %d.%d.%d\n", version->pixHFString, version->pixHWVersion, version->pixFWVersionMaj, version->pixFWVersionMin, version->pixFWBuild);
- *     
- *     // one must have already set signature with pixyMon2 to track colors
- *     printf("\nNow Tracking Colors\n");
- * 
- *     while (true)
- *     {
- *         // Ordering to track all color signature
- *
- *         // As tracking may take some time we use the main loop with a non blocking function to allow other task to be performed while camera is processing the image
- *         // Order is sent once, then function will return PIXY2_BUSY until color tracking result are made available
- *         if (cam.pixy2_getBlocks(255, 10) == PIXY2_OK) {
- * 
- *             led1 = !led1; //visual debug (not mandatory)
- * 
- *             // Displaying number of detected signature blocks
- *             printf("\nfound : %d blocs\n",cam.Pixy2_numBlocks);
- * 
- *             // Parsing thru signature blocs
- *             for (int i=0; i < cam.Pixy2_numBlocks; i++) {
- *                 
- *                 bloc = &cam.Pixy2_blocks[i]; // For a ease usage - still not mandatory - else use cam->Pixy2_blocks[i].<field> to access data 
- *                 
- *                 printf("bloc %d - sig = %d\n", i+1, bloc->pixSignature); // Display block siagnature
- *                 printf("\tposition : X = %d, Y = %d\n", bloc->pixX, bloc->pixY); // Display block position
- *                 printf("\tsize : H = %d, W = %d\n", bloc->pixHeight, bloc->pixWidth); // Display block size
- *             }
- *             ThisThread::sleep_for(WAIT_TIME_MS); // Only usefull for a debug
- *         } // Here you may check for erroneous responses
- *     }
- * }
- * \endcode
- */
-
-/**
- * Constructor of pixy2 UART object.
- *
- * @param tx : the Mbed pin used as TX
- * @param rx : the Mbed pin used as RX
- * @param debit : the bitrate of the serial (default & max value is 230 kbaud/s)
- */
-PIXY2(PinName tx, PinName rx, int debit = 230000);
-
-/**
- * Destructor of pixy2 UART object.
- */
-~PIXY2();
-
-// Public Types
-
-/**************** ERRORS ****************/
-
-/**
- *  \typedef T_pixy2ErrorCode
- *  \brief Explicit error code list :
- *  \param PIXY2_OK                 : No error
- *  \param PIXY2_MISC_ERROR         : Generic error
- *  \param PIXY2_BUSY               : Pixy is busy (the response message is not yet fully arrived)
- *  \param PIXY2_BAD_CHECKSUM       : Checksum is wrong
- *  \param PIXY2_TIMEOUT            : Pixy2 is not talking
- *  \param PIXY2_BUTTON_OVERRIDE    : User is manualy operating the button of the Pixy2
- *  \param PIXY2_PROG_CHANGE        : Checksum is wrong
- *  \param PIXY2_TYPE_ERROR         : Unexpected message type
- *  @note More documentation : 
- *  https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api#error-codes
- */
-typedef int             T_pixy2ErrorCode;
-
-/**************** SHORT HANDS ****************/
-
-/**
- *  \typedef Byte
- *  \brief   Short hand for unsigned char
- */
-typedef unsigned char   Byte;
- 
-/**
- *  \typedef sByte
- *  \brief   Short hand for signed char
- */
-typedef signed char     sByte;
- 
-/**
- *  \typedef Word
- *  \brief   Short hand for unsigned short
- */
-typedef unsigned short  Word;
- 
-/**
- *  \typedef sWord
- *  \brief   Short hand for signed short
- */
-typedef short           sWord;
-
-/**
- *  \typedef lWord
- *  \brief   Short hand for unsigned long
- */
-typedef unsigned long   lWord;
- 
- /**
- *  \typedef slWord
- *  \brief   Short hand for signed long
- */
-typedef long            slWord;
-
-
-/**************** PAYLOADS ****************/
-
-/**
- *  \struct T_pixy2Version
- *  \brief  Structured type that match pixy2 version frame message payload (ie : frame type = 14/15)
- *  \param  pixHWVersion    Word (16 bits integer) : hardWare Version of pixy2
- *  \param  pixFWVersionMaj Byte (8 bits integer)  : upper part of firmware (before the dot) 
- *  \param  pixFWVersionMin Byte (8 bits integer)  : lower part of firmware (after the dot)
- *  \param  pixFWBuild      Word (16 bits integer) : firmware build information
- *  \param  pixHFString     String (10 characters) : user friendly pixy2 firmware type
- */
-typedef struct {
-    Word                pixHWVersion;
-    Byte                pixFWVersionMaj;
-    Byte                pixFWVersionMin;
-    Word                pixFWBuild;
-    Byte                pixHFString[10];
-}T_pixy2Version;
-
-/**
- *  \struct T_pixy2Resolution
- *  \brief  Structured type that match pixy2 resolution frame (type = 12/13) message payload
- *  \param  pixFrameWidth   Word (16 bits integer) : width (in pixel) of an image
- *  \param  pixFrameHeight  Word (16 bits integer) : height (in pixel) of an image
- */
-typedef struct {
-    Word                pixFrameWidth;
-    Word                pixFrameHeight;
-}T_pixy2Resolution;
-
-/**
- *  \struct T_pixy2Bloc
- *  \brief  Structured type that match pixy2 blocks frame (type = 32/33) message payload
- *  \param  pixSignature Word (16 bits integer)         : signature or color code of the color bloc (signature are between 1 and 7, color code are composed of signature of 2, up to 5, tags so it's over 10)
- *  \param  pixX         Word (16 bits integer)         : X (horizontal axis) position of color bloc center, relative to the left of the image (in pixels, between 0 and 315)
- *  \param  pixY         Word (16 bits integer)         : Y (vertical axis) position of color bloc center, relative to the top of the image (in pixels, between 0 and 207)
- *  \param  pixWidth     Word (16 bits integer)         : width (in pixels, between 0 and 316) of color bloc
- *  \param  pixHeight    Word (16 bits integer)         : height (in pixels, between 0 and 208) of color bloc
- *  \param  pixAngle     sWord (16 bits signed integer) : angle (in degree, between -180.0 and +180.0) of a color code bloc
- *  \param  pixIndex     Byte (8 bits integer)          : tracking identification of the color code bloc (set by pixy2 to ease a bloc position following program)
- *  \param  pixAge       Byte (8 bits integer)          : age (in number of frame) of a bloc (doesn't wrap around).
- *  @note More info can be found here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:ccc_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:color_connected_components
- */
-typedef struct {
-    Word                pixSignature;
-    Word                pixX;
-    Word                pixY;
-    Word                pixWidth;
-    Word                pixHeight;
-    sWord               pixAngle;
-    Byte                pixIndex;
-    Byte                pixAge;
-}T_pixy2Bloc;
-
-/**
- *  \struct T_pixy2Vector
- *  \brief  Structured type that match pixy2 vector definition - used in Line frame (type 48/49) - message payload
- *  \param  pixX0     Byte (8 bits integer) : X (horizontal, relative to the left of image) position of the tail of the vector (number between 0 and 78)
- *  \param  pixY0     Byte (8 bits integer) : Y (vertical, relative to the top of image) position of the tail of the vector (number between 0 and 51)
- *  \param  pixX1     Byte (8 bits integer) : X (horizontal, relative to the left of image) position of the head of the vector (number between 0 and 78)
- *  \param  pixY1     Byte (8 bits integer) : Y (vertical, relative to the top of image) position of the head of the vector (number between 0 and 51)
- *  \param  pixIndex  Byte (8 bits integer) : tracking identification of the vector (set by pixy2 to ease a vector identification in case of multiple vector in a line following program)
- *  \param  pixFlags  Byte (8 bits integer) : flag containing possible usefull informations (see notes)
- *  @note This structure is a feature of Line API, packed as a feature in a Line Frame, documented here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- */
-typedef struct {
-    Byte                pixX0;
-    Byte                pixY0;
-    Byte                pixX1;
-    Byte                pixY1;
-    Byte                pixIndex;
-    Byte                pixFlags;
-}T_pixy2Vector;
-
-/**
- *  \struct T_pixy2InterLine
- *  \brief  Structured type that match pixy2 intersection line definition - used in Line frame (type 48/49) - message payload 
- *  \param  pixIndex     Byte (8 bits integer)          : tracking identification of the intersection line (set by pixy2 to ease a line following program)
- *  \param  pixReserved  Byte                           : Not documented by manufacturer
- *  \param  pixAngle     sWord (16 bits signed integer) : angle (in degree, between -180.0 and +180.0) of the intersection line
- *  @note This structure is a sub feature of Line API, packed as a sub feature of intersection feature in a Line Frame, documented here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
- *  @note More info can be found here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- */
-typedef struct {
-    Byte                pixIndex;
-    Byte                pixReserved;
-    sWord               pixAngle;
-}T_pixy2InterLine;
-
-/**
- *  \struct T_pixy2Intersection
- *  \brief  Structured type that match pixy2 intersection definition - used in Line frame (type 48/49) - message payload 
- *  \param  pixX         Byte (8 bits integer)              : X axis coordinate of the intersection (in pixel, between 0 and 78)
- *  \param  pixY         Byte (8 bits integer)              : Y axis coordinate of the intersection (in pixel, between 0 and 51)
- *  \param  pixN         Byte (8 bits integer)              : Number of lines connected to the intersection (between 3 and 5) 
- *  \param  pixReserved  Byte                               : Not documented by manufacturer
- *  \param  pixIntLines  T_pixy2InterLine (strucutre array) : lines converging into the intersection
- *  @note This structure is a feature of Line API, packed as a feature in a Line Frame, documented here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
- *  @note More info can be found here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- */
-typedef struct {
-    Byte                pixX;
-    Byte                pixY;
-    Byte                pixN;
-    Byte                pixReserved;
-    T_pixy2InterLine    PixintLines[PIXY2_MAX_INT_LINE];
-}T_pixy2Intersection;
-
-/**
- *  \struct T_pixy2BarCode
- *  \brief  Structured type that match pixy2 barcode definition - used in Line frame (type 48/49) - message payload 
- *  \param  pixX         Byte (8 bits integer) : X axis coordinate of the barcode (in pixel, between 0 and 78)
- *  \param  pixY         Byte (8 bits integer) : Y axis coordinate of the barcode (in pixel, between 0 and 51)
- *  \param  pixFlag      Byte (8 bits integer) : Flag to indicate if barcode met filtering constraint 
- *  \param  pixCode      Byte (8 bits integer) : Indicate the numeric value associated with the barcode (between 0 and 15)
- *  @note This structure is a feature of Line API, packed as a feature in a Line Frame, documented here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
- *  @note More info can be found here : 
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- */
-typedef struct {
-    Byte                pixX;
-    Byte                pixY;
-    Byte                pixFlag;
-    Byte                pixCode;
-}T_pixy2BarCode;
-
-/**
- *  \struct T_pixy2LineFeature
- *  \brief  Structured type that match pixy2 feature header for Line API - used in Line frame (type 48/49) - message payload 
- *  \param  pixType      Byte (8 bits integer) : type of the feature (can be 1 -> Vector, 2 -> Intersection or 4 -> Barcode)
- *  \param  pixLength    Byte (8 bits integer) : Number of Bytes for this feature
- *  @note This structure is the header of features of Line API in Line Frames. They can be up to 4 features in a frame. Documented here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
- *  @note More info can be found here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- */
-typedef struct {
-    Byte                fType;
-    Byte                fLength;
-}T_pixy2LineFeature;
-
-/**
- *  \struct T_pixy2Pixel
- *  \brief  Structured type that match pixy2 video API - used in Video frame (type 112/1) - message payload 
- *  \param  pixBlue      Byte (8 bits integer) : Blue RGB value of the average blue component of the 5x5 pixels square centered on X param passes to the function (value between 0 and 255)
- *  \param  pixGreen     Byte (8 bits integer) : Green RGB value of the average blue component of the 5x5 pixels square centered on X param passes to the function (value between 0 and 255)
- *  \param  pixRed       Byte (8 bits integer) : Red RGB value of the average blue component of the 5x5 pixels square centered on X param passes to the function (value between 0 and 255)
- *  @note More info can be found here :
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
- *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video
- */
-typedef struct {
-    Byte                pixBlue;
-    Byte                pixGreen;
-    Byte                pixRed;
-}T_pixy2Pixel;
-
-/**
- *  \struct T_pixy2ReturnCode
- *  \brief  Structured type that match pixy2 error/acknowledge/reply frame (type = 1 or 3) message payload
- *  \param  pixReturn    lWord (32 bits integer) : returned value
- */
-typedef struct {
-    lWord               pixReturn;
-}T_pixy2ReturnCode;
-
-// Public Functions
-
-/**
- * Get the firmware, build and hardware version of Pixy2,
- * @brief Result are mapped to the T_pixy2Version class member variable type object passed by address.
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param ptrVersion T_pixy2Version (structure, passed by address) : pointer to a pointer of the version data structure
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_getVersion (T_pixy2Version **ptrVersion);
-
-/**
- * Get the width and height of the frames used by the camera's current program.
- * @brief Result are mapped to the T_pixy2Resolution class member variable type object passed by address.
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param ptrResolution T_pixy2Resolution (structure, passed by address) : pointer to a pointer of the resolution data structure
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_getResolution (T_pixy2Resolution **ptrResolution);
-
-/**
- * Set the relative exposure level of Pixy2's image sensor.
- * @brief Higher values of brightness result in a brighter (more exposed) image. 
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param brightness Byte (passed by value) : Brightness level 
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_setCameraBrightness (Byte brightness);
-
-/**
- * Set the servo positions of servos plugged into Pixy2's two RC servo connectors. 
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param s0 Word (passed by value) : value between 0 and 511 
- * @param s1 Word (passed by value) : value between 0 and 511 
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_setServos (Word s0, Word s1);
-
-/**
- * Set Pixy2's RGB LED value.
- * @brief The three arguments sets the brightness of the red, green and blue sections of the LED. It will override Pixy2's own setting of the RGB LED. 
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param red   Byte (passed by value) : Red component value (between 0 and 255) 
- * @param green Byte (passed by value) : Green component value (between 0 and 255) 
- * @param blue  Byte (passed by value) : Blue component value (between 0 and 255) 
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_setLED (Byte red, Byte green, Byte blue);
-
-/**
- * Set on/off Pixy2's integrated light source.
- * @brief The upper parameter controls the two white LEDs along the top edge of Pixy2's PCB. The lower argument sets the RGB LED, causing it to turn on all three color channels at full brightness, resulting in white light. It will override Pixy2's own setting of the RGB LED. 
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param upper Byte (passed by value) : switch on or off the upper lamps (boolean : zero or non-zero)
- * @param lower Byte (passed by value) : switch on or off the lower lamp (boolean : zero or non-zero) 
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_setLamp (Byte upper, Byte lower);
-
-/**
- * Get Pixy2's framerate.
- * @brief Result are mapped to the T_pixy2ReturnCode class member variable type object passed by address.
- * @note The framerate can range between 2 and 62 frames per second depending on the amount of light in the environment and the min frames per second setting in the Camera configuration tab.
- * @note This function can also serve as a simple indicator of the amount of light in the environment. That is, low framerates indicate low light level.
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param framerate T_pixy2ReturnCode (structure, passed by address) : number of frame per second (between 2 and 62) 
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_getFPS (T_pixy2ReturnCode **framerate);
-
-/**
- * Get all detected color blocks in the most recent frame.
- * @brief Results are mapped to the PIXY2_blocks array, and number of detected blocs is stored in PIXY2_numBlocks, both are created by the constructor
- * @note The returned blocks are sorted by area, with the largest blocks appearing first in the PIXY2_blocks array.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:color_connected_components
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__ccc_api
- * @param sigmap        Byte (passed by value)          : signature filtering (see note below)
- * @param maxBloc       Byte (passed by value)          : maximum number of blocks to return (between 1 and 255)
- * @return T_pixy2ErrorCode : error code.
- * @note There are 7 different signatures definition (sig1 to sig7). Color codes are made of a combination of signature and can be filtered as well. 
- * @note Filtering is based on ORing codes : 1 for sig1, 2 for sig2, 4 for sig3, 8 for sig4, 16 for sig5, 32 for sig6, 64 for sig7 and 128 for "color code".
- * @note So sigmap = 255 means accept all and sigmap = 0 means reject all. For example filtering to get only sig1 and sig5 is done using sigmap = 17 (1 + 16).
- * @note Results are mapped in 2 variables created by the Pixy2 object :
- * @note PIXY2_numBlocks Byte                           : The number of blocks detected
- * @note PIXY2_blocks    T_pixy2Bloc (structure array)  : The list of detected blocks
- * @note see class code example for more informations
- */
-T_pixy2ErrorCode pixy2_getBlocks (Byte sigmap, Byte maxBloc);
-
-/**
- * Get the latest main features of Line tracking in the most recent frame.
- * @brief Results are mapped in the PIXY2_vectors, PIXY2_intersections, and PIXY2_barcodes, arrays respectively, with the number of detected objects of a kind in PIXY2_numVectors, PIXY2_numIntersection and PIXY2_numBarecode respectively. All are created by the constructor.
- * @note The main feature is the feature that is the most likely to be relevant for single line traking.
- * @note In case of multiple vector detection (for example 2 lines unconnected), the function will return only the vector of the line you are the most likely to follow.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param feature               Byte (passed by value)                : feature filtering 
- * @return T_pixy2ErrorCode                                           : error code.
- * @note There are 3 possible features (vectors, intersections and barcodes).
- * @note Filtering is based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
- * @note So 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode is done using feature = 5 (1 + 4).
- * @note Results are mapped in 6 variables of the object :
- * @note PIXY2_numVectors       Byte                                  : Number of Vectors detected
- * @note PIXY2_numIntersections Byte                                  : Number of Intersections detected
- * @note PIXY2_numBarcodes      Byte                                  : Number of Barcodes detected
- * @note PIXY2_vectors          T_pixy2Vector (structure array)       : List of detected vectors
- * @note PIXY2_intersections    T_pixy2Intersection (structure array) : List of detected intersections
- * @note PIXY2_barcode          T_pixy2BarCode (structure array)      : List of detected Barcodes
- */
-T_pixy2ErrorCode pixy2_getMainFeature (Byte features);
-
-/**
- * Get all the latest features of Line tracking in the most recent frame.
- * @brief Results are mapped in the PIXY2_vectors, PIXY2_intersections, and PIXY2_barcodes, arrays respectively, with the number of detected objects of a kind in PIXY2_numVectors, PIXY2_numIntersection and PIXY2_numBarecode respectively. All are created by the constructor.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param feature               Byte (passed by value)                : feature filtering 
- * @return T_pixy2ErrorCode                                           : error code (if negative) or ORing of feature detected (if positive).
- * @note There are 3 possible features (vectors, intersections and barcodes).
- * @note Filtering or detected feature are based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
- * @note So for filtering : 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode means using feature = 5 (1 + 4).
- * @note So for return value : 1 means only vector(s) detected, 2 means only intersection(s) detected, 3 vector(s) and intersection(s) detected and so on.
- * @note Results are mapped in 6 variables of the object :
- * @note PIXY2_numVectors       Byte                                  : Number of Vectors detected
- * @note PIXY2_numIntersections Byte                                  : Number of Intersections detected
- * @note PIXY2_numBarcodes      Byte                                  : Number of Barcodes detected
- * @note PIXY2_vectors          T_pixy2Vector (structure array)       : List of detected vectors
- * @note PIXY2_intersections    T_pixy2Intersection (structure array) : List of detected intersections
- * @note PIXY2_barcode          T_pixy2BarCode (structure array)      : List of detected Barcodes
- */
-T_pixy2ErrorCode pixy2_getAllFeature (Byte features);
-
-/**
- * Set various modes in the line tracking algorithm.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param mode      Byte (passed by value)  : ORing of required feature 
- * @return T_pixy2ErrorCode                 : error code.
- * @note There are 3 possible features :
- * @note * LINE_MODE_TURN_DELAYED : Normally, the line tracking algorithm will choose the straightest path (branch) when encountering an intersection. Setting LINE_MODE_TURN_DELAYED will prevent the line tracking algorithm from choosing the path automatically. This is useful if your program doesn't know beforehand which path it wants to take at the next intersection.
- * @note * LINE_MODE_MANUAL_SELECT_VECTOR : Normally, the line tracking algorithm will choose what it thinks to be the best Vector line automatically. Setting LINE_MODE_MANUAL_SELECT_VECTOR will prevent the line tracking algorithm from choosing the Vector automatically. Instead, your program will need to set the Vector by calling setVector().
- * @note * LINE_MODE_WHITE_LINE : Normally, the line tracking algorithm will try to find dark lines on a light background (black lines). Setting LINE_MODE_WHITE_LINE will instruct the line tracking algorithm to look for light lines on a dark background (white lines).
- */
-T_pixy2ErrorCode pixy2_setMode (Byte mode);
-
-/**
- * Set the line tracking algorithm whith the path it should take at the next intersection.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param angle sWord (passed by value) : angle closest to the next turn (in degree, between -180 and 180) 
- * @return T_pixy2ErrorCode             : error code.
- * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
- * @note setNextTurn() will remember the turn angle you give it, and execute it at the next intersection. The line tracking algorithm will then go back to the default turn angle for subsequent intersections.
- * @note Upon encountering an intersection, the line tracking algorithm will find the path in the intersection that matches the turn angle most closely. 
- */
-T_pixy2ErrorCode pixy2_setNextTurn (sWord angle);
-
-/**
- * Set the line tracking algorithm whith path to choose by default upon encountering an intersection.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param angle sWord (passed by value) : angle closest to the default turn (in degree, between -180 and 180) 
- * @return T_pixy2ErrorCode             : error code.
- * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
- * @note The line tracking algorithm will find the path in the intersection that matches the default turn angle most closely.
- * @note A call to setNextTurn() will supercede the default turn angle for the next intersection.
- */
-T_pixy2ErrorCode pixy2_setDefaultTurn (sWord angle);
-
-/**
- * Set witch vector the tracking algorithm must choose as default route upon encountering an intersection.
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param index Byte (passed by value)  : index of the line to follow 
- * @return T_pixy2ErrorCode             : error code.
- * @note If the LINE_MODE_MANUAL_SELECT_VECTOR mode bit is set, the line tracking algorithm will no longer choose the Vector automatically. Instead, setVector() will set the Vector by providing the index of the line.
- */
-T_pixy2ErrorCode pixy2_setVector (Byte vectorIndex);
-
-/**
- * Set the tracking algorithm to reverse the head and the tail of vectors
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @return T_pixy2ErrorCode : error code.
- * @note The Vector has a direction that normally points up, from the bottom of the camera frame to the top of the camera frame for a forward-moving robot. Calling reverseVector() will invert the vector. This will typically cause your robot to back-up and change directions.
- */
-T_pixy2ErrorCode pixy2_ReverseVector (void);
-
-/**
- * Get the average RGB components of a square of 5x5 pixels centered on the given pixel coordinate
- * @note General description :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video
- * @note Frame Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation :
- * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
- * @param x         Word (passed by value)                      : X coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 315) 
- * @param y         Word (passed by value)                      : Y coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 207)
- * @param saturate  Byte (passed by value)                      : scale the 3 RGB components so that the highest one of the 3 RGB components is set to 255 (boolean : zero or non-zero) 
- * @param pixel     T_pixy2Pixel (structure, passed by address) : RGB pixel component. 
- * @return T_pixy2ErrorCode                                     : error code.
- */
-T_pixy2ErrorCode pixy2_getRGB (Word x, Word y, Byte saturate, T_pixy2Pixel **pixel);
-
-// Public Global Variables
-/**
- * @var Byte Pixy2_numBlocks
- * @brief number of color blocks in Pixy2_blocks
- */
-Byte                Pixy2_numBlocks;
-
-/**
- * @var T_pixy2Bloc Pixy2_blocks[]
- * @brief color blocks detected in the last frame
- */
-T_pixy2Bloc         *Pixy2_blocks;
-
-/**
- * @var Byte Pixy2_numVectors
- * @brief number of vectors in Pixy2_vectors
- */
-Byte                Pixy2_numVectors;
-
-/**
- * @var T_pixy2Vector Pixy2_vectors[]
- * @brief vectors detected in the last frame
- */
-T_pixy2Vector       *Pixy2_vectors;
-
-/**
- * @var Byte Pixy2_numIntersections
- * @brief number of intersections in Pixy2_intersections
- */
-Byte                Pixy2_numIntersections;
-
-/**
- * @var T_pixy2Intersection Pixy2_intersections[]
- * @brief intersections detected in the last frame
- */
-T_pixy2Intersection *Pixy2_intersections;
-
-/**
- * @var T_pixy2InterLine Pixy2_interLines[]
- * @brief lines detected in the last frame
- */
-T_pixy2InterLine *Pixy2_interLines;
-
-/**
- * @var Byte Pixy2_numBarcodes
- * @brief number of barcodes in Pixy2_blocks
- */
-Byte                Pixy2_numBarcodes;
-
-/**
- * @var T_pixy2BarCode Pixy2_barcodes[]
- * @brief bacodes detected in the last frame
- */
-T_pixy2BarCode      *Pixy2_barcodes;
-
-private :
-
-/**************** STATE MACHINE ****************/
-
-typedef enum {idle, messageSent, receivingHeader, receivingData, dataReceived} T_Pixy2State;
-
-// Variables globales Privées
-/**
- * @var etat (T_Pixy2State) state of the pixy2 cam (idle = No action, messageSent = Query or Set message sent, receivingHeader = Camera is respondig to the query/set, receivingData = Header received, dataReceived = All data has been recovered)
- * @var Pixy2_buffer (Array of Byte) bytes received from camera
- * @var wPointer (Byte) write pointer, pointing the next free cell of the array of received bytes
- * @var hPointer (Byte) header pointer, pointing on the begining of the header field in the array of received bytes
- * @var dPointer (Byte) data pointer, pointing on the begining of the data field in the array of received bytes
- * @var dataSize (Byte) number of bytes in the data field
- * @var frameContainChecksum (Byte) indicate if the received frame contains a checksum
- */
-T_Pixy2State        etat;
-Byte*               Pixy2_buffer;
-Byte                wPointer, hPointer, dPointer, dataSize;
-Byte                frameContainChecksum;
-
-// Fonctions privées
-
-/**
- * Queries the firmware and hardware version of Pixy2.
- * This function is part of the pixy2_getVersion function who treat the reply to this query.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndGetVersion (void);
-
-/**
- * Queries width and height of the frames used by the current program.
- * This function is part of the pixy2_getResolution function who treat the reply to this query.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndGetResolution (void);
-
-/**
- * Sends the relative exposure level of Pixy2's image sensor.
- * Higher values result in a brighter (more exposed) image.
- * This function is part of the pixy2_setCameraBrightness function who treat the acknowledge of this frame.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param brightness (Byte - passed by value) : brightness level
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndSetCameraBrightness (Byte brightness);
-
-/**
- * Sends the servo positions of servos plugged into Pixy2's two RC servo connectors.
- * This function is part of the pixy2_setServo function who treat the acknowledge of this frame.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param s0 (Word - passed by value) : value between 0 and 511
- * @param s1 (Word - passed by value) : value between 0 and 511
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndSetServo (Word s0, Word s1);
-
-/**
- * Sends Pixy2's RGB LED value. The three arguments sets the brightness of the red, green and blue sections of the LED.
- * It will override Pixy2's own setting of the RGB LED.
- * This function is part of the pixy2_setLED function who treat the acknowledge of this frame.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param red (Byte - passed by value) : Red component value (between 0 and 255)
- * @param green (Byte - passed by value) : Green component value (between 0 and 255)
- * @param blue (Byte - passed by value) : Blue component value (between 0 and 255)
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndSetLED (Byte red, Byte green, Byte blue);
-
-/**
- * Sends command that turns on/off Pixy2's integrated light source.
- * The upper argument controls the two white LEDs along the top edge of Pixy2's PCB. The lower argument sets the RGB LED, causing it to turn on all three color channels at full brightness, resulting in white light.
- * It will override Pixy2's own setting of the RGB LED.
- * This function is part of the pixy2_setLamp function who treat the acknowledge of this frame.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @param upper (Byte - passed by value) : switch on or off the upper lamps (boolean : zero or non-zero)
- * @param lower (Byte - passed by value) : switch on or off the lower lamp (boolean : zero or non-zero)
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndSetLamp (Byte upper, Byte lower);
-
-/**
- * Queries Pixy2's framerate.
- * This function is part of the pixy2_getFPS function who treat the reply to this query.
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndGetFPS (void);
-
-/**
- * Queries all detected color blocks in the most recent frame.
- * This function is part of the pixy2_getBlocks function who treat the reply to this query.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:color_connected_components
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__ccc_api
- * @param sigmap (Byte - passed by value) : signature filtering
- * @param maxBloc (Byte - passed by value) : maximum number of blocks to return
- * @return T_pixy2ErrorCode : error code.
- * @note There are 7 different signatures definition (sig1 to sig7). Color codes are made of a combination of signature and can be filtered as well.
- * @note Filtering is based on ORing codes : 1 for sig1, 2 for sig2, 4 for sig3, 8 for sig4, 16 for sig5, 32 for sig6, 64 sor sig7 and 128 for color code.
- * @note So sigmap = 255 means accept all and sigmap = 0 means reject all. For example filtering to get only sig1 and sig5 means using sigmap = 17 (16 + 1).
- */
-T_pixy2ErrorCode pixy2_sndGetBlocks (Byte sigmap, Byte maxBloc);
-
-/**
- * Queries the latest features of Line tracking in the most recent frame.
- * The results are returned in the variables vectors, intersections, and barcodes, respectively.
- * This function is part of the pixy2_getMainFeature or pixy2_getAllFeature function who treat the reply to this query.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param type (Byte - passed by value) : select between Main or All features (0 for main feature only, 1 for all features)
- * @param feature (Byte - passed by value) : feature filtering
- * @return T_pixy2ErrorCode : error code (if negative) or ORing of feature detected (if positive).
- * @note There are 3 possible features (vectors, intersections and barcodes).
- * @note Filtering or detected feature are based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
- * @note So for filtering : 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode means using feature = 5 (1 + 4).
- * @note So for return value : 1 means only vector(s) detected, 2 means only intersection(s) detected, 3 vector(s) and intersection(s) detected and so on.
- */
-T_pixy2ErrorCode pixy2_sndGetLineFeature (Byte type, Byte feature);
-
-/**
- * Sets various modes in the line tracking algorithm.
- * This function is part of the pixy2_setMode function who treat the acknowledge of this frame.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param mode (Byte - passed by value) : ORing of required feature
- * @return T_pixy2ErrorCode : error code.
- * @note There are 3 possible features :
- * @note * LINE_MODE_TURN_DELAYED : Normally, the line tracking algorithm will choose the straightest path (branch) when encountering an intersection. Setting LINE_MODE_TURN_DELAYED will prevent the line tracking algorithm from choosing the path automatically. This is useful if your program doesn't know beforehand which path it wants to take at the next intersection.
- * @note * LINE_MODE_MANUAL_SELECT_VECTOR : Normally, the line tracking algorithm will choose what it thinks is the best Vector line automatically. Setting LINE_MODE_MANUAL_SELECT_VECTOR will prevent the line tracking algorithm from choosing the Vector automatically. Instead, your program will need to set the Vector by calling setVector().
- * @note * LINE_MODE_WHITE_LINE : Normally, the line tracking algorithm will try to find dark lines on a light background (black lines). Setting LINE_MODE_WHITE_LINE will instruct the line tracking algorithm to look for light lines on a dark background (white lines).
- */
-T_pixy2ErrorCode pixy2_sndSetMode (Byte mode);
-
-/**
- * Tells the line tracking algorithm which path it should take at the next intersection.
- * This function is part of the pixy2_setNextTurn function who treat the acknowledge of this frame.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param angle (sWord - passed by value) : angle closest to the next turn (in degree, between -180 and 180)
- * @return T_pixy2ErrorCode : error code.
- * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
- * @note setNextTurn() will remember the turn angle you give it, and execute it at the next intersection. The line tracking algorithm will then go back to the default turn angle for subsequent intersections.
- * @note Upon encountering an intersection, the line tracking algorithm will find the path in the intersection that matches the turn angle most closely.
- */
-T_pixy2ErrorCode pixy2_sndSetNextTurn (Word angle);
-
-/**
- * Tells the line tracking algorithm which path to choose by default upon encountering an intersection.
- * This function is part of the pixy2_setDefaultTurn function who treat the acknowledge of this frame.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param angle (sWord - passed by value) : angle closest to the default turn (in degree, between -180 and 180)
- * @return T_pixy2ErrorCode : error code.
- * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
- * @note The line tracking algorithm will find the path in the intersection that matches the default turn angle most closely.
- * @note A call to setNextTurn() will supercede the default turn angle for the next intersection.
- */
-T_pixy2ErrorCode pixy2_sndSetDefaultTurn (Word angle);
-
-/**
- * Tells witch vector the tracking algorithm must choose as default route upon encountering an intersection.
- * This function is part of the pixy2_setVector function who treat the acknowledge of this frame.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param vectorindex (Byte - passed by value) : index of the vector to follow
- * @return T_pixy2ErrorCode : error code.
- * @note If the LINE_MODE_MANUAL_SELECT_VECTOR mode bit is set, the line tracking algorithm will no longer choose the Vector automatically. Instead, setVector() will set the Vector by providing the index of the line.
- */
-T_pixy2ErrorCode pixy2_sndSetVector (Byte vectorIndex);
-
-/**
- * Reverse the head and the tail of vectors
- * This function is part of the pixy2_reverseVector function who treat the acknowledge of this frame.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @return T_pixy2ErrorCode : error code.
- * @note The Vector has a direction. It normally points up, from the bottom of the camera frame to the top of the camera frame for a forward-moving robot. Calling reverseVector() will invert the vector. This will typically cause your robot to back-up and change directions.
- */
-T_pixy2ErrorCode pixy2_sndReverseVector (void);
-
-/**
- * Queries the average RGB components of a square of 5x5 pixels centered on the given pixel coordinate
- * This function is part of the pixy2_getRGB function who treat the reply to this query.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
- * @param x (Word - passed by value) : X coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 315) 
- * @param y (Word - passed by value) : Y coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 207)
- * @param saturate (Byte - passed by value) : scale the 3 RGB components so that the highest one of the 3 RGB components is set to 255 (boolean : zero or non-zero) 
- * @param pixel (T_pixy2Pixel - passed by reference) : RGB pixel. 
- * @return T_pixy2ErrorCode : error code.
- */
-T_pixy2ErrorCode pixy2_sndGetRGB (Word x, Word y, Byte saturate);
-
-/**
- * Gets all the latest features of Line tracking in the most recent frame.
- * The results are returned in the variables vectors, intersections, and barcodes, respectively.
- * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
- * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
- * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
- * @param feature (Byte - passed by value) : feature filtering
- * @return T_pixy2ErrorCode : error code.
- * @note There are 3 possible features (vectors, intersections and barcodes).
- * @note Filtering is based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
- * @note So 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode means using feature = 5 (1 + 4).
- */
-T_pixy2ErrorCode pixy2_getFeatures (void);
-
-void pixy2_getByte ();
-T_pixy2ErrorCode pixy2_validateChecksum (Byte* tab);
-
-
-/**************** UTILS ****************/
-
-/**
- *  \union  T_Word
- *  \brief  Structured type to switch from word to bytes
- *  \param  mot (Word)   : 16 bits word
- *  \param  octet (Byte) : 2 bytes that overlap mot (byte access)
- */
-typedef union {
-    Word    mot;
-    Byte    octet[2];
-}T_Word;
-
-/**
- *  \union T_lWord
- *  \brief  Structured type to switch from lword to word or bytes
- *  \param  motLong (lWord) : 32 bits word
- *  \param  mot (Word)      : 2 x 16 bits words that overlap motLong (word access)
- *  \param  octet (Byte)    : 4 bytes that overlap motLong (byte access)
- */
-typedef union {
-    lWord   motLong;
-    Word    mot[2];
-    Byte    octet[4];
-}T_lWord;
-
-
-/**************** HEADERS ****************/
-
-/**
- *  \struct T_pixy2Header
- *  \brief  Structured type that match pixy2 header without checksum (send message)
- *  \param  pixSync   (Word) : 16 bits synchro word - could be 0xc1ae (PIXY2_SYNC) or 0xc1af (PIXY2_CSSYNC)
- *  \param  pixType   (Byte) : 8 bits message type identifier
- *  \param  pixLength (Byte) : 8 bits message payload length (payload doesn't include checksum) 
- */
-typedef struct {
-    Word                pixSync;
-    Byte                pixType;
-    Byte                pixLength;
-}T_pixy2Header;
-
-/**
- *  \struct T_pixy2SendFrame
- *  \brief  Structured type that match frame definition for all kind of message to send to a pixy2 
- *  \param  header (T_pixy2Header) : 4 bytes classical header starting with PIXY2_SYNC
- *  \param  data   (Byte)          : 5 bytes payload (to match all usage, not all byte must be used)
- */
-typedef struct {
-    T_pixy2Header       header;
-    Byte                data[5];
-}T_pixy2SendFrame;
-
-/**
- *  \union  T_pixy2SendBuffer
- *  \brief  Structured type to switch between structured type T_pixy2sendFrame and bytes 
- *  \param  frame (T_pixy2SendFrame) : classical frame (header + payload) starting with PIXY2_SYNC
- *  \param  data  (Byte)             : 9 bytes that overlap frame (byte access)
- */
-typedef union {
-    T_pixy2SendFrame    frame;
-    Byte                data[9];
-}T_pixy2SendBuffer;
-
-/**
- *  \struct T_pixy2RcvHeader
- *  \brief  Structured type that match pixy2 header with checksum (received message)
- *  \param  pixSync   (Word) : 16 bits synchro word - could be 0xc1ae (PIXY2_SYNC) or 0xc1af (PIXY2_CSSYNC)
- *  \param  pixType   (Byte) : 8 bits message type identifier
- *  \param  pixLength (Byte) : 8 bits message payload length (payload doesn't include checksum) 
- *  \param  pixSync   (Word) : 16 bits checksum (sum of all bytes of the payload)
- */
-typedef struct {
-    Word                pixSync;
-    Byte                pixType;
-    Byte                pixLength;
-    Word                pixChecksum;
-}T_pixy2RcvHeader;
-
-protected :
-
-UnbufferedSerial*  _Pixy2;
-
-// POUR DEBUG //
-T_Pixy2State getEtat();
-void affDataSize();
-
-}; // End Class
-
-#endif        
+/**
+ * @file pixy2.h
+ * @brief Header file containing the pixy2 class compatible with mbed-os 6 (baremetal or multithread) using UART interface with non blocking functions
+ * @author Hugues Angelis - Théo Le Paih - Wael Hazami
+ * @date March 2022
+ *
+ * @section LICENSE
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * CMUCAM 5 - Pixy2 using UART interface (Serial)
+ * 
+ * Datasheet, FAQ and PC drivers :
+ *
+ * http://www.pixycam.com/
+ * This library was written by H. Angelis and tested by T. Le Paih and W. Hazami
+ */
+
+#ifndef _PIXY2_
+#define _PIXY2_
+
+/**
+ * Include : Mbed Library
+ */
+#include "mbed.h"
+
+/**
+ * Defines
+ */
+#define _DEBUG_ 1
+#define PIXY2_NCSHEADERSIZE 4
+#define PIXY2_CSHEADERSIZE  6
+#define PIXY2_SYNC          0xC1AE
+#define PIXY2_CSSYNC        0xC1AF
+#define PIXY2_REP_ACK       1
+#define PIXY2_REP_ERROR     3
+#define PIXY2_ASK_RESOL     12
+#define PIXY2_REP_RESOL     13
+#define PIXY2_ASK_VERS      14
+#define PIXY2_REP_VERS      15
+#define PIXY2_SET_BRIGHT    16
+#define PIXY2_SET_SERVOS    18
+#define PIXY2_SET_LED       20
+#define PIXY2_SET_LAMP      22
+#define PIXY2_ASK_FPS       24
+#define PIXY2_REP_FPS       1
+#define PIXY2_ASK_BLOC      32
+#define PIXY2_REP_BLOC      33
+#define PIXY2_ASK_LINE      48
+#define PIXY2_REP_LINE      49
+#define PIXY2_SET_MODE      54
+#define PIXY2_SET_TURN      58
+#define PIXY2_SET_VECTOR    56
+#define PIXY2_SET_DEFTURN   60
+#define PIXY2_SET_REVERSE   62
+#define PIXY2_ASK_VIDEO     112
+#define PIXY2_VECTOR        1
+#define PIXY2_INTERSECTION  2
+#define PIXY2_BARCODE       4
+#define PIXY2_MAX_INT_LINE  6
+#define PIXY2_MAX_BLOCS     18      // 255 bytes of payload max / 14 bytes per bloc
+#define PIXY2_NOISE         0xFF    // cluster number of a bloc that belongs to no cluster
+#define PIXY2_MAX_TRACKS    PIXY2_MAX_BLOCS
+#define PIXY2_NO_TRACK      0       // track id of a bloc that is not tracked
+#define PIXY2_LINE_WIDTH    79      // width of the line tracking grid
+#define PIXY2_LINE_HEIGHT   52      // height of the line tracking grid
+#define PIXY2_LENS_SIZE     33      // number of entries of the lens correction table
+#define PIXY2_MAX_VECTORS   42      // 255 bytes of payload max / 6 bytes per vector
+#define PIXY2_MAX_INTERS    9       // 255 bytes of payload max / 28 bytes per intersection
+#define PIXY2_GRID_BLOCS    0       // coordinate grid of color blocks (resolution of the camera program)
+#define PIXY2_GRID_LINE     1       // coordinate grid of line features (PIXY2_LINE_WIDTH x PIXY2_LINE_HEIGHT)
+#define PIXY2_GROUND_NONE   ((slWord) 0x80000000)  // ground coordinate of a point above the horizon
+#define PIXY2_HEAT_COLS     16      // number of columns of the detection heatmap
+#define PIXY2_HEAT_ROWS     12      // number of rows of the detection heatmap
+#define PIXY2_HEAT_HIT      256     // heat added to a cell for each block center
+#define PIXY2_MAX_TRIGGERS  8       // number of entries of the trigger table
+#define PIXY2_TRIG_NONE     0       // unused trigger
+#define PIXY2_TRIG_BLOC     1       // trigger on a block inside a rectangle
+#define PIXY2_TRIG_VECTOR   2       // trigger on a vector crossing a line
+#define PIXY2_MAX_FILTER_STAGES 8   // maximum number of predicates of a blocks filter
+#define PIXY2_LOG_SIZE      32      // number of records of the log ring (power of 2)
+#define PIXY2_LOG_OFF       0       // log levels
+#define PIXY2_LOG_ERROR     1
+#define PIXY2_LOG_WARNING   2
+#define PIXY2_LOG_INFO      3
+#define PIXY2_LOG_DEBUG     4
+#ifndef PIXY2_LOG_LEVEL
+#define PIXY2_LOG_LEVEL     PIXY2_LOG_ERROR // log records above this level are compiled out (may be set in mbed_app.json)
+#endif
+#define PIXY2_EVT_BAD_CHECKSUM  0   // log events (see pixy2_readLog)
+#define PIXY2_EVT_TYPE_ERROR    1
+#define PIXY2_EVT_CAM_ERROR     2
+#define PIXY2_EVT_BLOCS         3
+#define PIXY2_EVT_FEATURES      4
+#define PIXY2_EVT_MEASURE       5
+#define PIXY2_EVT_TIMEOUT       6
+#define PIXY2_EVT_NUMBER        7
+#define PIXY2_REC_SECTOR    512     // size of a sector of the detection log (see pixy2_setRecorder)
+#define PIXY2_REC_MAGIC     0xB2    // first byte of a sector of the detection log
+#define PIXY2_REC_VERSION   1       // version of the detection log format
+#define PIXY2_PUB_SLOTS     4       // number of frames kept by the publisher (see pixy2_setPublisher)
+#define PIXY2_STATS_SLOTS   8       // statistics of signatures 1 to 7, and of color codes (slot 0)
+#define PIXY2_STATS_CC      0       // statistics slot of the color codes
+#define PIXY2_ANGLE_BINS    12      // number of bins of the angle histogram (30 degrees each)
+#define PIXY2_CLASSES       4       // number of command classes (see pixy2_setRateLimit)
+#define PIXY2_CLASS_DETECT  0       // blocks and line features requests
+#define PIXY2_CLASS_ACTUATOR 1      // servos, LED and lamp
+#define PIXY2_CLASS_CONFIG  2       // brightness and line tracking settings
+#define PIXY2_CLASS_QUERY   3       // version, resolution, FPS and pixel color requests
+#define PIXY2_RATE_REQUESTS 0       // rate limit in requests per second
+#define PIXY2_RATE_BYTES    1       // rate limit in bytes (sent) per second
+#define PIXY2_MAX_WAYPOINTS 8       // maximum number of points of a servo trajectory
+#define PIXY2_DEFER_FRAMES  2       // number of frames waiting for the processing thread (see pixy2_setDeferred)
+#define PIXY2_NORM_ONE      32768   // normalised coordinate of the right / bottom edge of the frame (Q15, see pixy2_setNormalised)
+#define PIXY2_CAP_GENERAL   0x01    // capabilities of the firmware (see pixy2_getVersion) : version, resolution, FPS, brightness, servos, LED and lamp
+#define PIXY2_CAP_BLOCS     0x02    // color connected components (getBlocks)
+#define PIXY2_CAP_LINE      0x04    // line tracking (features, mode, turns, vector selection)
+#define PIXY2_CAP_VIDEO     0x08    // pixel color (getRGB)
+#define PIXY2_CAP_ALL       0x0F    // capabilities assumed until the version is known
+#define PIXY2_CAM_ERRORS    8       // number of camera error counters (index -code for codes -1 to -7, 0 for any other code)
+#define PIXY2_POLICY_REPORT 0       // camera error policy (see pixy2_setErrorPolicy) : the error code is returned to the caller
+#define PIXY2_POLICY_RETRY  1       // PIXY2_BUSY is returned, the next call sends the request again
+#define PIXY2_POLICY_BACKOFF 2      // PIXY2_BUSY is returned and no request is sent before the backoff delay
+#define PIXY2_POLICY_REINIT 3       // the cached version and resolution are dropped and the error code is returned
+#define PIXY2_FAILURES      3       // number of failure types of the retry policy (see pixy2_setRetryPolicy)
+#define PIXY2_FAIL_CHECKSUM 0       // answer with a bad checksum
+#define PIXY2_FAIL_TYPE     1       // answer of an unexpected type
+#define PIXY2_FAIL_TIMEOUT  2       // no answer before the timeout (see pixy2_setTimeout)
+#define PIXY2_REQUESTS      15      // number of request types (each keeps its own retry state)
+#define PIXY2_RETRY_SHIFT   5       // the backoff delay doubles for the first PIXY2_RETRY_SHIFT attempts, then stays at 16 times the first delay
+
+// setMode
+#define LINE_MODE_TURN_DELAYED                   0x01
+#define LINE_MODE_MANUAL_SELECT_VECTOR           0x02
+#define LINE_MODE_WHITE_LINE                     0x80
+
+#define PIXY2_OK             0
+#define PIXY2_BUSY          -1
+#define PIXY2_MISC_ERROR    -2
+#define PIXY2_BAD_CHECKSUM  -3
+#define PIXY2_TIMEOUT       -4
+#define PIXY2_OVERRIDE      -5
+#define PIXY2_PROG_CHANGE   -6
+#define PIXY2_TYPE_ERROR    -7
+#define PIXY2_THROTTLED     -8
+#define PIXY2_UNSUPPORTED   -9
+
+class PIXY2 {
+
+public :
+
+/**
+ * \class PIXY2 pixy2.h
+ * Pixy2 : CMU CAM 5 - Smart camera - Using UART interface - non blocking
+ * \brief More informations at http://www.pixycam.com/
+ * \note We use pointer to pointer in order to connect data received from UART and stored in a circular buffer, with structured objects (passed by address to the function)
+ * of the class that point to the reception buffer. You don't have to allocate memory for those objects as they point directly into the reception buffer : see example below
+ * \note Sending an order (ie : transmitting data to the camera is blocking), reception is non blocking
+ * \note As all functions are non blocking (ie : they return immediately after sending the order) and as communication, and image processing at 30 FPS, may take some time 
+ * you must wait for the function to complete its task before using the result or sending another order. When function return something else than PIXY2_BUSY then task has been processed.
+ * The example program below shows how to communicate with Pixy2.
+ *
+ * \code
+ * #include "mbed.h"
+ * #include "Pixy2.h"
+ * 
+ * #define WAIT_TIME_MS 100ms 
+ * DigitalOut led1(LED1);
+ * PIXY2 cam (PIXY_TX, PIXY_RX, 230000);
+ * 
+ * int main()
+ * {
+ *     T_pixy2ErrorCode rCode;  // return Code
+ *     T_pixy2Version *version; // Version for Pixy2 (no allocation needed)
+ *     T_pixy2Bloc *bloc;       // Easy to use Color Code Bloc (not mandatory, no allocation needed)
+ * 
+ *     printf("\nPixy running on Mbed OS %d.%d.%d.\n", MBED_MAJOR_VERSION, MBED_MINOR_VERSION, MBED_PATCH_VERSION);
+ * 
+ *     printf("Playing with RGB LED : ");
+ * 
+ *     do {
+ *         // switching on red led
+ *         rCode = cam.pixy2_setLED (0xFF,0,0);
+ *     } while (rCode == PIXY2_BUSY); // waiting for PIXY2 acknowledge (ie : order processed)
+ *
+ *     // here you may check if return code indicate an erroneous response
+ *
+ *     ThisThread::sleep_for(500ms);  // to allow visual detection 
+ * 
+ *     do {
+ *         // Switching off red led
+ *         rCode = cam.pixy2_setLED (0,0,0);
+ *     } while (rCode == PIXY2_BUSY); // waiting for acknowledge (ie : order processed)
+ *
+ *     // here you may check if return code indicate an erroneous response
+ *
+ *     printf("done\n");
+ * 
+ *     printf("Reading Version : ");
+ *     do {
+ *         // Asking for Pixy2 Version
+ *         rCode = cam.pixy2_getVersion (&version); //address of "version" will be somewhere in the reception buffer
+ *     } while (rCode == PIXY2_BUSY); // waiting for acknowledge (ie : order processed)
+ *
+ *     // here you may check if return code indicate an erroneous response
+ *
+ *     printf("done\n");
+ * 
+ *     printf("Pixy : %s (HW : %d) - FW : %d.%d.%d\n", version->pixHFString, version->pixHWVersion, version->pixFWVersionMaj, version->pixFWVersionMin, version->pixFWBuild);
+ *     
+ *     // one must have already set signature with pixyMon2 to track colors
+ *     printf("\nNow Tracking Colors\n");
+ * 
+ *     while (true)
+ *     {
+ *         // Ordering to track all color signature
+ *
+ *         // As tracking may take some time we use the main loop with a non blocking function to allow other task to be performed while camera is processing the image
+ *         // Order is sent once, then function will return PIXY2_BUSY until color tracking result are made available
+ *         if (cam.pixy2_getBlocks(255, 10) == PIXY2_OK) {
+ * 
+ *             led1 = !led1; //visual debug (not mandatory)
+ * 
+ *             // Displaying number of detected signature blocks
+ *             printf("\nfound : %d blocs\n",cam.Pixy2_numBlocks);
+ * 
+ *             // Parsing thru signature blocs
+ *             for (int i=0; i < cam.Pixy2_numBlocks; i++) {
+ *                 
+ *                 bloc = &cam.Pixy2_blocks[i]; // For a ease usage - still not mandatory - else use cam->Pixy2_blocks[i].<field> to access data 
+ *                 
+ *                 printf("bloc %d - sig = %d\n", i+1, bloc->pixSignature); // Display block siagnature
+ *                 printf("\tposition : X = %d, Y = %d\n", bloc->pixX, bloc->pixY); // Display block position
+ *                 printf("\tsize : H = %d, W = %d\n", bloc->pixHeight, bloc->pixWidth); // Display block size
+ *             }
+ *             ThisThread::sleep_for(WAIT_TIME_MS); // Only usefull for a debug
+ *         } // Here you may check for erroneous responses
+ *     }
+ * }
+ * \endcode
+ */
+
+/**
+ * Constructor of pixy2 UART object.
+ *
+ * @param tx : the Mbed pin used as TX
+ * @param rx : the Mbed pin used as RX
+ * @param debit : the bitrate of the serial (default & max value is 230 kbaud/s)
+ */
+PIXY2(PinName tx, PinName rx, int debit = 230000);
+
+/**
+ * Destructor of pixy2 UART object.
+ */
+~PIXY2();
+
+// Public Types
+
+/**************** ERRORS ****************/
+
+/**
+ *  \typedef T_pixy2ErrorCode
+ *  \brief Explicit error code list :
+ *  \param PIXY2_OK                 : No error
+ *  \param PIXY2_MISC_ERROR         : Generic error
+ *  \param PIXY2_BUSY               : Pixy is busy (the response message is not yet fully arrived)
+ *  \param PIXY2_BAD_CHECKSUM       : Checksum is wrong
+ *  \param PIXY2_TIMEOUT            : Pixy2 is not talking
+ *  \param PIXY2_BUTTON_OVERRIDE    : User is manualy operating the button of the Pixy2
+ *  \param PIXY2_PROG_CHANGE        : Checksum is wrong
+ *  \param PIXY2_TYPE_ERROR         : Unexpected message type
+ *  \param PIXY2_THROTTLED          : Request not sent, its command class is over its rate limit (see pixy2_setRateLimit)
+ *  \param PIXY2_UNSUPPORTED        : Request not sent, the firmware of the camera can't handle it (see pixy2_getVersion)
+ *  @note More documentation : 
+ *  https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api#error-codes
+ */
+typedef int             T_pixy2ErrorCode;
+
+/**************** SHORT HANDS ****************/
+
+/**
+ *  \typedef Byte
+ *  \brief   Short hand for unsigned char
+ */
+typedef unsigned char   Byte;
+ 
+/**
+ *  \typedef sByte
+ *  \brief   Short hand for signed char
+ */
+typedef signed char     sByte;
+ 
+/**
+ *  \typedef Word
+ *  \brief   Short hand for unsigned short
+ */
+typedef unsigned short  Word;
+ 
+/**
+ *  \typedef sWord
+ *  \brief   Short hand for signed short
+ */
+typedef short           sWord;
+
+/**
+ *  \typedef lWord
+ *  \brief   Short hand for unsigned long
+ */
+typedef unsigned long   lWord;
+ 
+ /**
+ *  \typedef slWord
+ *  \brief   Short hand for signed long
+ */
+typedef long            slWord;
+
+
+/**************** PAYLOADS ****************/
+
+/**
+ *  \struct T_pixy2Version
+ *  \brief  Structured type that match pixy2 version frame message payload (ie : frame type = 14/15)
+ *  \param  pixHWVersion    Word (16 bits integer) : hardWare Version of pixy2
+ *  \param  pixFWVersionMaj Byte (8 bits integer)  : upper part of firmware (before the dot) 
+ *  \param  pixFWVersionMin Byte (8 bits integer)  : lower part of firmware (after the dot)
+ *  \param  pixFWBuild      Word (16 bits integer) : firmware build information
+ *  \param  pixHFString     String (10 characters) : user friendly pixy2 firmware type
+ */
+typedef struct {
+    Word                pixHWVersion;
+    Byte                pixFWVersionMaj;
+    Byte                pixFWVersionMin;
+    Word                pixFWBuild;
+    Byte                pixHFString[10];
+}T_pixy2Version;
+
+/**
+ *  \struct T_pixy2Resolution
+ *  \brief  Structured type that match pixy2 resolution frame (type = 12/13) message payload
+ *  \param  pixFrameWidth   Word (16 bits integer) : width (in pixel) of an image
+ *  \param  pixFrameHeight  Word (16 bits integer) : height (in pixel) of an image
+ */
+typedef struct {
+    Word                pixFrameWidth;
+    Word                pixFrameHeight;
+}T_pixy2Resolution;
+
+/**
+ *  \struct T_pixy2Bloc
+ *  \brief  Structured type that match pixy2 blocks frame (type = 32/33) message payload
+ *  \param  pixSignature Word (16 bits integer)         : signature or color code of the color bloc (signature are between 1 and 7, color code are composed of signature of 2, up to 5, tags so it's over 10)
+ *  \param  pixX         Word (16 bits integer)         : X (horizontal axis) position of color bloc center, relative to the left of the image (in pixels, between 0 and 315)
+ *  \param  pixY         Word (16 bits integer)         : Y (vertical axis) position of color bloc center, relative to the top of the image (in pixels, between 0 and 207)
+ *  \param  pixWidth     Word (16 bits integer)         : width (in pixels, between 0 and 316) of color bloc
+ *  \param  pixHeight    Word (16 bits integer)         : height (in pixels, between 0 and 208) of color bloc
+ *  \param  pixAngle     sWord (16 bits signed integer) : angle (in degree, between -180.0 and +180.0) of a color code bloc
+ *  \param  pixIndex     Byte (8 bits integer)          : tracking identification of the color code bloc (set by pixy2 to ease a bloc position following program)
+ *  \param  pixAge       Byte (8 bits integer)          : age (in number of frame) of a bloc (doesn't wrap around).
+ *  @note More info can be found here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:ccc_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:color_connected_components
+ */
+typedef struct {
+    Word                pixSignature;
+    Word                pixX;
+    Word                pixY;
+    Word                pixWidth;
+    Word                pixHeight;
+    sWord               pixAngle;
+    Byte                pixIndex;
+    Byte                pixAge;
+}T_pixy2Bloc;
+
+/**
+ *  \struct T_pixy2Vector
+ *  \brief  Structured type that match pixy2 vector definition - used in Line frame (type 48/49) - message payload
+ *  \param  pixX0     Byte (8 bits integer) : X (horizontal, relative to the left of image) position of the tail of the vector (number between 0 and 78)
+ *  \param  pixY0     Byte (8 bits integer) : Y (vertical, relative to the top of image) position of the tail of the vector (number between 0 and 51)
+ *  \param  pixX1     Byte (8 bits integer) : X (horizontal, relative to the left of image) position of the head of the vector (number between 0 and 78)
+ *  \param  pixY1     Byte (8 bits integer) : Y (vertical, relative to the top of image) position of the head of the vector (number between 0 and 51)
+ *  \param  pixIndex  Byte (8 bits integer) : tracking identification of the vector (set by pixy2 to ease a vector identification in case of multiple vector in a line following program)
+ *  \param  pixFlags  Byte (8 bits integer) : flag containing possible usefull informations (see notes)
+ *  @note This structure is a feature of Line API, packed as a feature in a Line Frame, documented here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ */
+typedef struct {
+    Byte                pixX0;
+    Byte                pixY0;
+    Byte                pixX1;
+    Byte                pixY1;
+    Byte                pixIndex;
+    Byte                pixFlags;
+}T_pixy2Vector;
+
+/**
+ *  \struct T_pixy2InterLine
+ *  \brief  Structured type that match pixy2 intersection line definition - used in Line frame (type 48/49) - message payload 
+ *  \param  pixIndex     Byte (8 bits integer)          : tracking identification of the intersection line (set by pixy2 to ease a line following program)
+ *  \param  pixReserved  Byte                           : Not documented by manufacturer
+ *  \param  pixAngle     sWord (16 bits signed integer) : angle (in degree, between -180.0 and +180.0) of the intersection line
+ *  @note This structure is a sub feature of Line API, packed as a sub feature of intersection feature in a Line Frame, documented here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
+ *  @note More info can be found here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ */
+typedef struct {
+    Byte                pixIndex;
+    Byte                pixReserved;
+    sWord               pixAngle;
+}T_pixy2InterLine;
+
+/**
+ *  \struct T_pixy2Intersection
+ *  \brief  Structured type that match pixy2 intersection definition - used in Line frame (type 48/49) - message payload 
+ *  \param  pixX         Byte (8 bits integer)              : X axis coordinate of the intersection (in pixel, between 0 and 78)
+ *  \param  pixY         Byte (8 bits integer)              : Y axis coordinate of the intersection (in pixel, between 0 and 51)
+ *  \param  pixN         Byte (8 bits integer)              : Number of lines connected to the intersection (between 3 and 5) 
+ *  \param  pixReserved  Byte                               : Not documented by manufacturer
+ *  \param  pixIntLines  T_pixy2InterLine (strucutre array) : lines converging into the intersection
+ *  @note This structure is a feature of Line API, packed as a feature in a Line Frame, documented here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
+ *  @note More info can be found here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ */
+typedef struct {
+    Byte                pixX;
+    Byte                pixY;
+    Byte                pixN;
+    Byte                pixReserved;
+    T_pixy2InterLine    PixintLines[PIXY2_MAX_INT_LINE];
+}T_pixy2Intersection;
+
+/**
+ *  \struct T_pixy2BarCode
+ *  \brief  Structured type that match pixy2 barcode definition - used in Line frame (type 48/49) - message payload 
+ *  \param  pixX         Byte (8 bits integer) : X axis coordinate of the barcode (in pixel, between 0 and 78)
+ *  \param  pixY         Byte (8 bits integer) : Y axis coordinate of the barcode (in pixel, between 0 and 51)
+ *  \param  pixFlag      Byte (8 bits integer) : Flag to indicate if barcode met filtering constraint 
+ *  \param  pixCode      Byte (8 bits integer) : Indicate the numeric value associated with the barcode (between 0 and 15)
+ *  @note This structure is a feature of Line API, packed as a feature in a Line Frame, documented here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
+ *  @note More info can be found here : 
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ */
+typedef struct {
+    Byte                pixX;
+    Byte                pixY;
+    Byte                pixFlag;
+    Byte                pixCode;
+}T_pixy2BarCode;
+
+/**
+ *  \struct T_pixy2LineFeature
+ *  \brief  Structured type that match pixy2 feature header for Line API - used in Line frame (type 48/49) - message payload 
+ *  \param  pixType      Byte (8 bits integer) : type of the feature (can be 1 -> Vector, 2 -> Intersection or 4 -> Barcode)
+ *  \param  pixLength    Byte (8 bits integer) : Number of Bytes for this feature
+ *  @note This structure is the header of features of Line API in Line Frames. They can be up to 4 features in a frame. Documented here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:protocol_reference
+ *  @note More info can be found here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ */
+typedef struct {
+    Byte                fType;
+    Byte                fLength;
+}T_pixy2LineFeature;
+
+/**
+ *  \struct T_pixy2Pixel
+ *  \brief  Structured type that match pixy2 video API - used in Video frame (type 112/1) - message payload 
+ *  \param  pixBlue      Byte (8 bits integer) : Blue RGB value of the average blue component of the 5x5 pixels square centered on X param passes to the function (value between 0 and 255)
+ *  \param  pixGreen     Byte (8 bits integer) : Green RGB value of the average blue component of the 5x5 pixels square centered on X param passes to the function (value between 0 and 255)
+ *  \param  pixRed       Byte (8 bits integer) : Red RGB value of the average blue component of the 5x5 pixels square centered on X param passes to the function (value between 0 and 255)
+ *  @note More info can be found here :
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
+ *  @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video
+ */
+typedef struct {
+    Byte                pixBlue;
+    Byte                pixGreen;
+    Byte                pixRed;
+}T_pixy2Pixel;
+
+/**
+ *  \struct T_pixy2ReturnCode
+ *  \brief  Structured type that match pixy2 error/acknowledge/reply frame (type = 1 or 3) message payload
+ *  \param  pixReturn    lWord (32 bits integer) : returned value
+ */
+typedef struct {
+    lWord               pixReturn;
+}T_pixy2ReturnCode;
+
+/**
+ *  \struct T_pixy2Cluster
+ *  \brief  Structured type that describe a group of color blocks (see pixy2_setClustering)
+ *  \param  pixX         Word (16 bits integer)  : X position of the centroid of the cluster (mean of the centers of its blocks, in pixels)
+ *  \param  pixY         Word (16 bits integer)  : Y position of the centroid of the cluster (mean of the centers of its blocks, in pixels)
+ *  \param  pixLeft      Word (16 bits integer)  : left edge of the bounding box of the cluster (in pixels)
+ *  \param  pixTop       Word (16 bits integer)  : top edge of the bounding box of the cluster (in pixels)
+ *  \param  pixRight     Word (16 bits integer)  : right edge of the bounding box of the cluster (in pixels)
+ *  \param  pixBottom    Word (16 bits integer)  : bottom edge of the bounding box of the cluster (in pixels)
+ *  \param  pixNumBlocs  Byte (8 bits integer)   : number of blocks in the cluster
+ *  \param  pixMembers   lWord (32 bits integer) : membership mask, bit i is set if bloc i belongs to the cluster
+ */
+typedef struct {
+    Word                pixX;
+    Word                pixY;
+    Word                pixLeft;
+    Word                pixTop;
+    Word                pixRight;
+    Word                pixBottom;
+    Byte                pixNumBlocs;
+    lWord               pixMembers;
+}T_pixy2Cluster;
+
+/**
+ *  \struct T_pixy2Track
+ *  \brief  Structured type that describe an object followed from frame to frame (see pixy2_setTracking)
+ *  \param  pixId       Byte (8 bits integer)         : identifier of the track (between 1 and 255, stable while the object is followed)
+ *  \param  pixMissed   Byte (8 bits integer)         : number of consecutive frames without any block associated to the track
+ *  \param  pixAge      Word (16 bits integer)        : number of frames with a block associated to the track
+ *  \param  pixBloc     T_pixy2Bloc (structure)       : last block associated to the track
+ */
+typedef struct {
+    Byte                pixId;
+    Byte                pixMissed;
+    Word                pixAge;
+    T_pixy2Bloc         pixBloc;
+}T_pixy2Track;
+
+/**
+ *  \struct T_pixy2GroundPoint
+ *  \brief  Structured type that describe a point on the ground plane (see pixy2_setHomography)
+ *  \param  pixX     slWord (32 bits signed integer) : X coordinate on the ground (unit is the one used for calibration, PIXY2_GROUND_NONE if the point is above the horizon)
+ *  \param  pixY     slWord (32 bits signed integer) : Y coordinate on the ground (unit is the one used for calibration, PIXY2_GROUND_NONE if the point is above the horizon)
+ */
+typedef struct {
+    slWord              pixX;
+    slWord              pixY;
+}T_pixy2GroundPoint;
+
+/**
+ *  \struct T_pixy2NormPoint
+ *  \brief  Structured type that describe a point in normalised coordinates (see pixy2_setNormalised)
+ *  \param  pixX     Word (16 bits integer) : X coordinate (Q15 : 0 is the left of the image, PIXY2_NORM_ONE its right)
+ *  \param  pixY     Word (16 bits integer) : Y coordinate (Q15 : 0 is the top of the image, PIXY2_NORM_ONE its bottom)
+ */
+typedef struct {
+    Word                pixX;
+    Word                pixY;
+}T_pixy2NormPoint;
+
+/**
+ *  \struct T_pixy2NormVector
+ *  \brief  Structured type that describe a vector of the line features in normalised coordinates (see pixy2_setNormalised and T_pixy2Vector)
+ *  \param  pixX0     Word (16 bits integer) : X position of the tail of the vector (Q15)
+ *  \param  pixY0     Word (16 bits integer) : Y position of the tail of the vector (Q15)
+ *  \param  pixX1     Word (16 bits integer) : X position of the head of the vector (Q15)
+ *  \param  pixY1     Word (16 bits integer) : Y position of the head of the vector (Q15)
+ *  \param  pixIndex  Byte (8 bits integer)  : tracking identification of the vector
+ *  \param  pixFlags  Byte (8 bits integer)  : flags of the vector
+ */
+typedef struct {
+    Word                pixX0;
+    Word                pixY0;
+    Word                pixX1;
+    Word                pixY1;
+    Byte                pixIndex;
+    Byte                pixFlags;
+}T_pixy2NormVector;
+
+/**
+ *  \struct T_pixy2Trigger
+ *  \brief  Structured type that describe a region of interest trigger (see pixy2_setTrigger)
+ *  \param  pixType      Byte (8 bits integer)   : PIXY2_TRIG_BLOC (a block of the signatures is inside the rectangle) or PIXY2_TRIG_VECTOR (a vector crosses the line)
+ *  \param  pixSigmap    Byte (8 bits integer)   : signatures of the blocks (same coding as pixy2_getBlocks sigmap, ignored for vectors)
+ *  \param  pixX0        Word (16 bits integer)  : left edge of the rectangle, or X of the first end of the line
+ *  \param  pixY0        Word (16 bits integer)  : top edge of the rectangle, or Y of the first end of the line
+ *  \param  pixX1        Word (16 bits integer)  : right edge of the rectangle, or X of the second end of the line
+ *  \param  pixY1        Word (16 bits integer)  : bottom edge of the rectangle, or Y of the second end of the line
+ *  \param  pixMinArea   lWord (32 bits integer) : minimum area (width x height, in square pixels) of the block (ignored for vectors)
+ *  \param  pixMaxArea   lWord (32 bits integer) : maximum area (width x height, in square pixels) of the block (ignored for vectors)
+ *  \param  pixOnFrames  Byte (8 bits integer)   : number of consecutive matching frames to activate the trigger (hysteresis, at least 1)
+ *  \param  pixOffFrames Byte (8 bits integer)   : number of consecutive non matching frames to deactivate the trigger (hysteresis, at least 1)
+ *  @note Line coordinates use the line features grid (PIXY2_LINE_WIDTH x PIXY2_LINE_HEIGHT), rectangles use the blocks grid.
+ */
+typedef struct {
+    Byte                pixType;
+    Byte                pixSigmap;
+    Word                pixX0;
+    Word                pixY0;
+    Word                pixX1;
+    Word                pixY1;
+    lWord               pixMinArea;
+    lWord               pixMaxArea;
+    Byte                pixOnFrames;
+    Byte                pixOffFrames;
+}T_pixy2Trigger;
+
+/**
+ *  \struct T_pixy2LogRecord
+ *  \brief  Structured type that describe a binary log record (see pixy2_readLog)
+ *  \param  logTime  lWord (32 bits integer)        : time of the event (in micro-seconds, us_ticker)
+ *  \param  logEvent Byte (8 bits integer)          : event (PIXY2_EVT_...)
+ *  \param  logLevel Byte (8 bits integer)          : level of the event (PIXY2_LOG_ERROR to PIXY2_LOG_DEBUG)
+ *  \param  logArg   Word (array of 3 16 bits integers) : arguments of the event (meaning depends on the event, see pixy2_formatLog)
+ */
+typedef struct {
+    lWord               logTime;
+    Byte                logEvent;
+    Byte                logLevel;
+    Word                logArg[3];
+}T_pixy2LogRecord;
+
+/**
+ *  \struct T_pixy2LinkStats
+ *  \brief  Structured type that describe the statistics of the link with a camera (see pixy2_getLinkStats)
+ *  \param  pixRequests       lWord (32 bits integer) : number of requests sent to the camera
+ *  \param  pixAnswers        lWord (32 bits integer) : number of complete answers received
+ *  \param  pixBytes          lWord (32 bits integer) : number of bytes received
+ *  \param  pixTimeouts       lWord (32 bits integer) : number of requests abandoned after the timeout (see pixy2_setTimeout)
+ *  \param  pixChecksumErrors lWord (32 bits integer) : number of answers with a bad checksum
+ *  \param  pixTypeErrors     lWord (32 bits integer) : number of answers of an unexpected type
+ *  \param  pixLatency        lWord (32 bits integer) : time between the last request and the last byte of its answer (in micro-seconds)
+ *  \param  pixWorstLatency   lWord (32 bits integer) : worst pixLatency (in micro-seconds)
+ *  \param  pixThrottled      lWord (array of PIXY2_CLASSES 32 bits integers) : number of requests of each command class refused by the rate limit (see pixy2_setRateLimit)
+ *  \param  pixCameraErrors   lWord (array of PIXY2_CAM_ERRORS 32 bits integers) : number of error replies of the camera, by code (index -code, 0 for unknown codes)
+ *  \param  pixRetries        lWord (32 bits integer) : number of requests sent again by the retry policy (included in pixRequests, see pixy2_setRetryPolicy)
+ *  \param  pixRetryFailures  lWord (32 bits integer) : number of requests that failed after all their attempts
+ */
+typedef struct {
+    lWord               pixRequests;
+    lWord               pixAnswers;
+    lWord               pixBytes;
+    lWord               pixTimeouts;
+    lWord               pixChecksumErrors;
+    lWord               pixTypeErrors;
+    lWord               pixLatency;
+    lWord               pixWorstLatency;
+    lWord               pixThrottled[PIXY2_CLASSES];
+    lWord               pixCameraErrors[PIXY2_CAM_ERRORS];
+    lWord               pixRetries;
+    lWord               pixRetryFailures;
+}T_pixy2LinkStats;
+
+/**
+ *  \struct T_pixy2CameraError
+ *  \brief  Structured type that describe an error reply of the camera (see pixy2_setErrorPolicy)
+ *  \param  pixCode     slWord (32 bits signed integer) : error code sent by the camera (PIXY2_MISC_ERROR if the reply has no payload)
+ *  \param  pixRequest  Byte (8 bits integer)           : type of the request answered by the error
+ *  \param  pixLength   Byte (8 bits integer)           : length of the payload of the reply
+ *  \param  pixTime     lWord (32 bits integer)         : date of the reply (in micro-seconds, us_ticker_read)
+ */
+typedef struct {
+    slWord              pixCode;
+    Byte                pixRequest;
+    Byte                pixLength;
+    lWord               pixTime;
+}T_pixy2CameraError;
+
+/**
+ *  \struct T_pixy2SigStats
+ *  \brief  Structured type that describe the statistics of the blocks of a signature over a window of frames (see pixy2_setStats)
+ *  \param  pixCount    lWord (32 bits integer)                        : number of blocks
+ *  \param  pixMean     slWord (array of 4 32 bits signed integers)    : mean of X, Y, width and height (Q8 : in 1/256 pixel)
+ *  \param  pixVariance lWord (array of 4 32 bits integers)            : variance of X, Y, width and height (Q8 : in 1/256 square pixel)
+ *  \param  pixAngles   Word (array of PIXY2_ANGLE_BINS 16 bits integers) : histogram of the angles (color codes only, bin 0 starts at -180 degrees)
+ */
+typedef struct {
+    lWord               pixCount;
+    slWord              pixMean[4];
+    lWord               pixVariance[4];
+    Word                pixAngles[PIXY2_ANGLE_BINS];
+}T_pixy2SigStats;
+
+/**
+ *  \struct T_pixy2Waypoint
+ *  \brief  Structured type that describe a point of a servo trajectory (see pixy2_setWaypoints)
+ *  \param  pixS0 Word (16 bits integer) : position of servo 0 (between 0 and 511)
+ *  \param  pixS1 Word (16 bits integer) : position of servo 1 (between 0 and 511)
+ */
+typedef struct {
+    Word                pixS0;
+    Word                pixS1;
+}T_pixy2Waypoint;
+
+/**
+ *  \struct T_pixy2Frame
+ *  \brief  Structured type that describe a blocks frame published for other threads (see pixy2_setPublisher)
+ *  \param  pixSequence    uint32_t (32 bits integer)  : sequence number of the frame (from 1, 0 while the slot is being written)
+ *  \param  pixRxTime      lWord (32 bits integer)     : time when the last byte of the frame was received (in micro-seconds, us_ticker)
+ *  \param  pixPublishTime lWord (32 bits integer)     : time when the frame was published (in micro-seconds, us_ticker)
+ *  \param  pixNumBlocks   Byte (8 bits integer)       : number of blocks of the frame
+ *  \param  pixBlocks      T_pixy2Bloc (array)         : blocks of the frame (after all enabled processing)
+ */
+typedef struct {
+    volatile uint32_t   pixSequence;
+    lWord               pixRxTime;
+    lWord               pixPublishTime;
+    Byte                pixNumBlocks;
+    T_pixy2Bloc         pixBlocks[PIXY2_MAX_BLOCS];
+}T_pixy2Frame;
+
+// Public Functions
+
+/**
+ * Get the firmware, build and hardware version of Pixy2,
+ * @brief Result are mapped to the T_pixy2Version class member variable type object passed by address.
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @note The version is read once : the first reply is cached (later calls return at once) and interpreted into the capabilities of the firmware (Pixy2_capabilities).
+ * A capability is only removed for the firmware builds documented without it (the video API, pixy2_getRGB, needs firmware 3.0.11 or later) :
+ * any other version, including unknown or unusual ones, keeps every capability, as if the version had not been read.
+ * From then, requests the firmware can't handle are refused locally with PIXY2_UNSUPPORTED, instead of waiting for an error reply of the camera.
+ * Call it once after the camera has started (until then, every request is assumed to be supported).
+ * @param ptrVersion T_pixy2Version (structure, passed by address) : pointer to a pointer of the version data structure
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_getVersion (T_pixy2Version **ptrVersion);
+
+/**
+ * Get the width and height of the frames used by the camera's current program.
+ * @brief Result are mapped to the T_pixy2Resolution class member variable type object passed by address.
+ * @note The resolution is cached : once known, it is returned at once without any exchange with the camera,
+ * until the camera reports a program change (PIXY2_PROG_CHANGE) or pixy2_invalidateResolution is called.
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param ptrResolution T_pixy2Resolution (structure, passed by address) : pointer to a pointer of the resolution data structure
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_getResolution (T_pixy2Resolution **ptrResolution);
+
+/**
+ * Forget the cached resolution (after the program of the camera has been changed by its button for example) : the next call of pixy2_getResolution asks the camera.
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_invalidateResolution (void);
+
+/**
+ * Force the capabilities of the camera (for a custom firmware for example), instead of the ones deduced from its version.
+ * @param capabilities Byte (passed by value) : capabilities (PIXY2_CAP_GENERAL is always set)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setCapabilities (Byte capabilities);
+
+/**
+ * Set the relative exposure level of Pixy2's image sensor.
+ * @brief Higher values of brightness result in a brighter (more exposed) image. 
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param brightness Byte (passed by value) : Brightness level 
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setCameraBrightness (Byte brightness);
+
+/**
+ * Set the servo positions of servos plugged into Pixy2's two RC servo connectors. 
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param s0 Word (passed by value) : value between 0 and 511 
+ * @param s1 Word (passed by value) : value between 0 and 511 
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setServos (Word s0, Word s1);
+
+/**
+ * Set Pixy2's RGB LED value.
+ * @brief The three arguments sets the brightness of the red, green and blue sections of the LED. It will override Pixy2's own setting of the RGB LED. 
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param red   Byte (passed by value) : Red component value (between 0 and 255) 
+ * @param green Byte (passed by value) : Green component value (between 0 and 255) 
+ * @param blue  Byte (passed by value) : Blue component value (between 0 and 255) 
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setLED (Byte red, Byte green, Byte blue);
+
+/**
+ * Set on/off Pixy2's integrated light source.
+ * @brief The upper parameter controls the two white LEDs along the top edge of Pixy2's PCB. The lower argument sets the RGB LED, causing it to turn on all three color channels at full brightness, resulting in white light. It will override Pixy2's own setting of the RGB LED. 
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param upper Byte (passed by value) : switch on or off the upper lamps (boolean : zero or non-zero)
+ * @param lower Byte (passed by value) : switch on or off the lower lamp (boolean : zero or non-zero) 
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setLamp (Byte upper, Byte lower);
+
+/**
+ * Get Pixy2's framerate.
+ * @brief Result are mapped to the T_pixy2ReturnCode class member variable type object passed by address.
+ * @note The framerate can range between 2 and 62 frames per second depending on the amount of light in the environment and the min frames per second setting in the Camera configuration tab.
+ * @note This function can also serve as a simple indicator of the amount of light in the environment. That is, low framerates indicate low light level.
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param framerate T_pixy2ReturnCode (structure, passed by address) : number of frame per second (between 2 and 62) 
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_getFPS (T_pixy2ReturnCode **framerate);
+
+/**
+ * Get all detected color blocks in the most recent frame.
+ * @brief Results are mapped to the PIXY2_blocks array, and number of detected blocs is stored in PIXY2_numBlocks, both are created by the constructor
+ * @note The returned blocks are sorted by area, with the largest blocks appearing first in the PIXY2_blocks array.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:color_connected_components
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__ccc_api
+ * @param sigmap        Byte (passed by value)          : signature filtering (see note below)
+ * @param maxBloc       Byte (passed by value)          : maximum number of blocks to return (between 1 and 255)
+ * @return T_pixy2ErrorCode : error code.
+ * @note There are 7 different signatures definition (sig1 to sig7). Color codes are made of a combination of signature and can be filtered as well. 
+ * @note Filtering is based on ORing codes : 1 for sig1, 2 for sig2, 4 for sig3, 8 for sig4, 16 for sig5, 32 for sig6, 64 for sig7 and 128 for "color code".
+ * @note So sigmap = 255 means accept all and sigmap = 0 means reject all. For example filtering to get only sig1 and sig5 is done using sigmap = 17 (1 + 16).
+ * @note Results are mapped in 2 variables created by the Pixy2 object :
+ * @note PIXY2_numBlocks Byte                           : The number of blocks detected
+ * @note PIXY2_blocks    T_pixy2Bloc (structure array)  : The list of detected blocks
+ * @note see class code example for more informations
+ */
+T_pixy2ErrorCode pixy2_getBlocks (Byte sigmap, Byte maxBloc);
+
+/**
+ * Get the detected color blocks of the most recent frame that are accepted by a filter.
+ * @brief Same as pixy2_getBlocks, except that the decoder applies the filter while walking the payload : only accepted blocks are kept (compacted at the begining of PIXY2_blocks)
+ * and counted in PIXY2_numBlocks, so rejected blocks are never seen by the post-processing stages nor by the caller.
+ * @note The filter is a chain of predicates composed at compile time (see PIXY2_FilterChain and the PIXY2_Filter... predicates at the end of this file), for example :
+ * @note cam.pixy2_getBlocks< PIXY2_FilterChain< PIXY2_FilterArea<100, 5000>, PIXY2_FilterRect<50, 20, 250, 180> > > (255, 10);
+ * @note Predicates are evaluated in order, a block is rejected by the first predicate it fails. Pixy2_filterCount[0] counts the accepted blocks
+ * and Pixy2_filterCount[k] the blocks rejected by the k-th predicate (counters are cumulative, the user may clear them), to help tuning the filter.
+ * @param sigmap        Byte (passed by value)          : signature filtering (see pixy2_getBlocks)
+ * @param maxBloc       Byte (passed by value)          : maximum number of blocks to return (between 1 and 255)
+ * @return T_pixy2ErrorCode : error code.
+ */
+template <class Filter>
+T_pixy2ErrorCode pixy2_getBlocks (Byte sigmap, Byte maxBloc);
+
+/**
+ * Get the latest main features of Line tracking in the most recent frame.
+ * @brief Results are mapped in the PIXY2_vectors, PIXY2_intersections, and PIXY2_barcodes, arrays respectively, with the number of detected objects of a kind in PIXY2_numVectors, PIXY2_numIntersection and PIXY2_numBarecode respectively. All are created by the constructor.
+ * @note The main feature is the feature that is the most likely to be relevant for single line traking.
+ * @note In case of multiple vector detection (for example 2 lines unconnected), the function will return only the vector of the line you are the most likely to follow.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param feature               Byte (passed by value)                : feature filtering 
+ * @return T_pixy2ErrorCode                                           : error code.
+ * @note There are 3 possible features (vectors, intersections and barcodes).
+ * @note Filtering is based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
+ * @note So 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode is done using feature = 5 (1 + 4).
+ * @note Results are mapped in 6 variables of the object :
+ * @note PIXY2_numVectors       Byte                                  : Number of Vectors detected
+ * @note PIXY2_numIntersections Byte                                  : Number of Intersections detected
+ * @note PIXY2_numBarcodes      Byte                                  : Number of Barcodes detected
+ * @note PIXY2_vectors          T_pixy2Vector (structure array)       : List of detected vectors
+ * @note PIXY2_intersections    T_pixy2Intersection (structure array) : List of detected intersections
+ * @note PIXY2_barcode          T_pixy2BarCode (structure array)      : List of detected Barcodes
+ */
+T_pixy2ErrorCode pixy2_getMainFeature (Byte features);
+
+/**
+ * Get all the latest features of Line tracking in the most recent frame.
+ * @brief Results are mapped in the PIXY2_vectors, PIXY2_intersections, and PIXY2_barcodes, arrays respectively, with the number of detected objects of a kind in PIXY2_numVectors, PIXY2_numIntersection and PIXY2_numBarecode respectively. All are created by the constructor.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param feature               Byte (passed by value)                : feature filtering 
+ * @return T_pixy2ErrorCode                                           : error code (if negative) or ORing of feature detected (if positive).
+ * @note There are 3 possible features (vectors, intersections and barcodes).
+ * @note Filtering or detected feature are based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
+ * @note So for filtering : 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode means using feature = 5 (1 + 4).
+ * @note So for return value : 1 means only vector(s) detected, 2 means only intersection(s) detected, 3 vector(s) and intersection(s) detected and so on.
+ * @note Results are mapped in 6 variables of the object :
+ * @note PIXY2_numVectors       Byte                                  : Number of Vectors detected
+ * @note PIXY2_numIntersections Byte                                  : Number of Intersections detected
+ * @note PIXY2_numBarcodes      Byte                                  : Number of Barcodes detected
+ * @note PIXY2_vectors          T_pixy2Vector (structure array)       : List of detected vectors
+ * @note PIXY2_intersections    T_pixy2Intersection (structure array) : List of detected intersections
+ * @note PIXY2_barcode          T_pixy2BarCode (structure array)      : List of detected Barcodes
+ */
+T_pixy2ErrorCode pixy2_getAllFeature (Byte features);
+
+/**
+ * Enable or disable the lazy decoding of line features.
+ * @brief By default pixy2_getMainFeature and pixy2_getAllFeature decode every feature of the frame (mapping, lens correction, ground projection).
+ * In lazy mode they only index the features of the frame in one pass (the returned value still tells which features are present),
+ * and each kind of feature is decoded the first time it is accessed with pixy2_lineVectors, pixy2_lineIntersections or pixy2_lineBarcodes.
+ * @note In lazy mode, PIXY2_vectors, PIXY2_intersections, PIXY2_barcodes and their counts are only valid after the corresponding access function has been called.
+ * @note Vectors are always decoded when a vector trigger is set (see pixy2_setTrigger).
+ * @note As with all mapped results, decoded features are only valid until the next request is sent to the camera.
+ * @param enable Byte (passed by value) : enable (non-zero) or disable (zero) the lazy mode
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setLazyFeatures (Byte enable);
+
+/**
+ * Get the vectors of the last line frame, decoding them on first access.
+ * @param vectors T_pixy2Vector (structure array, passed by address) : pointer to a pointer on the list of vectors
+ * @return Byte : number of vectors.
+ */
+Byte pixy2_lineVectors (T_pixy2Vector **vectors);
+
+/**
+ * Get the intersections of the last line frame, decoding them on first access.
+ * @param intersections T_pixy2Intersection (structure array, passed by address) : pointer to a pointer on the list of intersections
+ * @return Byte : number of intersections.
+ */
+Byte pixy2_lineIntersections (T_pixy2Intersection **intersections);
+
+/**
+ * Get the barcodes of the last line frame, decoding them on first access.
+ * @param barcodes T_pixy2BarCode (structure array, passed by address) : pointer to a pointer on the list of barcodes
+ * @return Byte : number of barcodes.
+ */
+Byte pixy2_lineBarcodes (T_pixy2BarCode **barcodes);
+
+/**
+ * Set various modes in the line tracking algorithm.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param mode      Byte (passed by value)  : ORing of required feature 
+ * @return T_pixy2ErrorCode                 : error code.
+ * @note There are 3 possible features :
+ * @note * LINE_MODE_TURN_DELAYED : Normally, the line tracking algorithm will choose the straightest path (branch) when encountering an intersection. Setting LINE_MODE_TURN_DELAYED will prevent the line tracking algorithm from choosing the path automatically. This is useful if your program doesn't know beforehand which path it wants to take at the next intersection.
+ * @note * LINE_MODE_MANUAL_SELECT_VECTOR : Normally, the line tracking algorithm will choose what it thinks to be the best Vector line automatically. Setting LINE_MODE_MANUAL_SELECT_VECTOR will prevent the line tracking algorithm from choosing the Vector automatically. Instead, your program will need to set the Vector by calling setVector().
+ * @note * LINE_MODE_WHITE_LINE : Normally, the line tracking algorithm will try to find dark lines on a light background (black lines). Setting LINE_MODE_WHITE_LINE will instruct the line tracking algorithm to look for light lines on a dark background (white lines).
+ */
+T_pixy2ErrorCode pixy2_setMode (Byte mode);
+
+/**
+ * Set the line tracking algorithm whith the path it should take at the next intersection.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param angle sWord (passed by value) : angle closest to the next turn (in degree, between -180 and 180) 
+ * @return T_pixy2ErrorCode             : error code.
+ * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
+ * @note setNextTurn() will remember the turn angle you give it, and execute it at the next intersection. The line tracking algorithm will then go back to the default turn angle for subsequent intersections.
+ * @note Upon encountering an intersection, the line tracking algorithm will find the path in the intersection that matches the turn angle most closely. 
+ */
+T_pixy2ErrorCode pixy2_setNextTurn (sWord angle);
+
+/**
+ * Set the line tracking algorithm whith path to choose by default upon encountering an intersection.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param angle sWord (passed by value) : angle closest to the default turn (in degree, between -180 and 180) 
+ * @return T_pixy2ErrorCode             : error code.
+ * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
+ * @note The line tracking algorithm will find the path in the intersection that matches the default turn angle most closely.
+ * @note A call to setNextTurn() will supercede the default turn angle for the next intersection.
+ */
+T_pixy2ErrorCode pixy2_setDefaultTurn (sWord angle);
+
+/**
+ * Set witch vector the tracking algorithm must choose as default route upon encountering an intersection.
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param index Byte (passed by value)  : index of the line to follow 
+ * @return T_pixy2ErrorCode             : error code.
+ * @note If the LINE_MODE_MANUAL_SELECT_VECTOR mode bit is set, the line tracking algorithm will no longer choose the Vector automatically. Instead, setVector() will set the Vector by providing the index of the line.
+ */
+T_pixy2ErrorCode pixy2_setVector (Byte vectorIndex);
+
+/**
+ * Set the tracking algorithm to reverse the head and the tail of vectors
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @return T_pixy2ErrorCode : error code.
+ * @note The Vector has a direction that normally points up, from the bottom of the camera frame to the top of the camera frame for a forward-moving robot. Calling reverseVector() will invert the vector. This will typically cause your robot to back-up and change directions.
+ */
+T_pixy2ErrorCode pixy2_ReverseVector (void);
+
+/**
+ * Get the average RGB components of a square of 5x5 pixels centered on the given pixel coordinate
+ * @note General description :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video
+ * @note Frame Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation :
+ * @note https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
+ * @param x         Word (passed by value)                      : X coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 315) 
+ * @param y         Word (passed by value)                      : Y coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 207)
+ * @param saturate  Byte (passed by value)                      : scale the 3 RGB components so that the highest one of the 3 RGB components is set to 255 (boolean : zero or non-zero) 
+ * @param pixel     T_pixy2Pixel (structure, passed by address) : RGB pixel component. 
+ * @return T_pixy2ErrorCode                                     : error code.
+ */
+T_pixy2ErrorCode pixy2_getRGB (Word x, Word y, Byte saturate, T_pixy2Pixel **pixel);
+
+/**
+ * Enable or disable the merging of fragmented color blocks.
+ * @brief Under uneven lighting one object may be reported as several adjacent blocks with the same signature.
+ * When enabled, each frame received by pixy2_getBlocks is processed and blocks of the same signature whose boxes overlap, or are separated by at most tolerance pixels, are united into a single block.
+ * @note The raw blocks are left untouched in Pixy2_blocks, the merged view is stored in Pixy2_mergedBlocks (Pixy2_numMergedBlocks blocks).
+ * @note A merged block takes the bounding box of its fragments, the index and angle of its largest fragment, and the age of its oldest fragment.
+ * @note Blocks are sorted by signature and left edge (heap sort, O(n log n)) and then swept, the sweep stops as soon as the next block starts beyond the current one.
+ * All working memory is static (PIXY2_MAX_BLOCS), the time spent is stored in Pixy2_mergeTime.
+ * @param enable    Byte (passed by value) : enable (non-zero) or disable (zero) the merging stage
+ * @param tolerance Word (passed by value) : maximum gap (in pixels) between two boxes to be merged (0 means boxes must touch or overlap)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setBlocMerging (Byte enable, Word tolerance);
+
+/**
+ * Enable or disable the clustering of color blocks into groups of objects.
+ * @brief When enabled, each frame received by pixy2_getBlocks is processed with a DBSCAN algorithm : blocks whose centers are closer than eps pixels are neighbours,
+ * a block with at least minBlocs neighbours (itself included) is a core block, and clusters are made of core blocks connected by neighbourhood plus the blocks they reach.
+ * @note Clustering is applied on Pixy2_mergedBlocks when merging is enabled (see pixy2_setBlocMerging), else on Pixy2_blocks.
+ * @note Results are mapped in 3 variables of the object :
+ * @note Pixy2_numClusters  Byte                            : Number of clusters found
+ * @note Pixy2_clusters     T_pixy2Cluster (structure array) : centroid, bounding box and members of each cluster
+ * @note Pixy2_blocCluster  Byte (array)                    : cluster number of each bloc (PIXY2_NOISE if the bloc belongs to no cluster)
+ * @note Neighbour search uses a grid of eps x eps cells stored as a sorted index (binary search on the 3 x 3 cells around a block), memory is static (PIXY2_MAX_BLOCS).
+ * The time spent is stored in Pixy2_clusterTime.
+ * @param enable    Byte (passed by value) : enable (non-zero) or disable (zero) the clustering stage
+ * @param eps       Word (passed by value) : neighbourhood radius (in pixels, at least 1)
+ * @param minBlocs  Byte (passed by value) : minimum number of neighbours of a core block (itself included, 1 means every block is in a cluster)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setClustering (Byte enable, Word eps, Byte minBlocs);
+
+/**
+ * Enable or disable the association of blocks from frame to frame (multi-target tracking).
+ * @brief The index given by the camera (pixIndex) may be reassigned after an occlusion, so when enabled each frame received by pixy2_getBlocks is associated
+ * to the current tracks by a global nearest neighbour method : a cost matrix (position and size difference) is built between tracks and blocks,
+ * pairs of different signature or whose cost is over gate are forbidden, and the assignment of minimum total cost is solved with the Hungarian algorithm.
+ * @note Tracking is applied on Pixy2_mergedBlocks when merging is enabled (see pixy2_setBlocMerging), else on Pixy2_blocks.
+ * @note A track that is not associated for more than maxMissed frames is deleted, a block that is not associated starts a new track.
+ * @note The Hungarian algorithm always ends in O(n^3) steps (n = PIXY2_MAX_BLOCS at most) and uses static memory only.
+ * The time spent on the last frame is stored in Pixy2_trackTime and the worst one in Pixy2_trackWorstTime.
+ * @note Results are mapped in 3 variables of the object :
+ * @note Pixy2_numTracks   Byte                          : Number of tracks
+ * @note Pixy2_tracks      T_pixy2Track (structure array) : List of tracks
+ * @note Pixy2_blocTrack   Byte (array)                  : track id of each block (PIXY2_NO_TRACK if none)
+ * @param enable    Byte (passed by value) : enable (non-zero) or disable (zero) the tracking stage (disabling deletes all tracks)
+ * @param gate      Word (passed by value) : maximum cost of an association (sum of X and Y distances and of half the width and height differences, in pixels)
+ * @param maxMissed Byte (passed by value) : number of frames a track survives without association (0 to 254)
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if maxMissed is 255).
+ */
+T_pixy2ErrorCode pixy2_setTracking (Byte enable, Word gate, Byte maxMissed);
+
+/**
+ * Enable or disable the lens distortion correction of blocks and line features coordinates.
+ * @brief Pixy2 lens model is radial : a point at distance ru from the image center (normalized by the half diagonal) is seen at rd = ru * (1 + k1 * ru^2 + k2 * ru^4).
+ * When enabled, the model is inverted once (in floating point) into a table of PIXY2_LENS_SIZE correction factors indexed by rd^2,
+ * then the coordinates of every block (pixX, pixY) and of every vector, intersection and barcode are corrected in fixed point when a frame is decoded.
+ * @note Block coordinates use the grid of the camera program (width x height, see pixy2_getResolution), line features use the PIXY2_LINE_WIDTH x PIXY2_LINE_HEIGHT grid.
+ * The table is shared, each grid has its own center and scale.
+ * @note Corrected coordinates are clamped to the grid. Sizes (pixWidth, pixHeight) are not corrected.
+ * @param enable  Byte (passed by value)  : enable (non-zero) or disable (zero) the correction
+ * @param width   Word (passed by value)  : width (in pixels) of the frames of the current program
+ * @param height  Word (passed by value)  : height (in pixels) of the frames of the current program
+ * @param k1      float (passed by value) : second order radial distortion coefficient (negative for a barrel distortion)
+ * @param k2      float (passed by value) : fourth order radial distortion coefficient
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setLensCorrection (Byte enable, Word width, Word height, float k1, float k2);
+
+/**
+ * Enable or disable the projection of blocks and line features on the ground plane.
+ * @brief The homography h (3 x 3 matrix, row major) maps a pixel (x, y) of a grid to the ground point (X, Y) :
+ * X = (h0.x + h1.y + h2) / (h6.x + h7.y + h8) and Y = (h3.x + h4.y + h5) / (h6.x + h7.y + h8). It is obtained by calibration (in any unit, millimeters for example).
+ * @note Blocks and line features do not use the same grid, so each grid has its own matrix, converted once to fixed point (Q32) and cached until the next call for this grid.
+ * @note When enabled, every decoded frame is transformed in one batch (pixy2_getBlocks : centers of blocks, pixy2_getMainFeature/pixy2_getAllFeature : vector ends and intersections),
+ * after lens correction if enabled. The time spent on the last batch and the number of points transformed are stored in Pixy2_groundTime and Pixy2_groundPoints.
+ * @note Results are mapped in 3 variables of the object, with the same indexes as the blocks, vectors and intersections :
+ * @note Pixy2_groundBlocks         T_pixy2GroundPoint (structure array)        : center of each block on the ground
+ * @note Pixy2_groundVectors        T_pixy2GroundPoint (array of 2 structures)  : tail (0) and head (1) of each vector on the ground
+ * @note Pixy2_groundIntersections  T_pixy2GroundPoint (structure array)        : intersections on the ground
+ * @param enable  Byte (passed by value)   : enable (non-zero) or disable (zero) the projection for this grid
+ * @param grid    Byte (passed by value)   : grid of the matrix (PIXY2_GRID_BLOCS or PIXY2_GRID_LINE)
+ * @param h       float (array of 9 values): homography matrix (row major), h8 must not be zero
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the matrix can't be converted).
+ */
+T_pixy2ErrorCode pixy2_setHomography (Byte enable, Byte grid, const float *h);
+
+/**
+ * Enable or disable the detection heatmap.
+ * @brief The heatmap is a grid of PIXY2_HEAT_COLS x PIXY2_HEAT_ROWS integer cells covering the frame (width x height, see pixy2_getResolution).
+ * When enabled, the center of each block of the frames received by pixy2_getBlocks adds PIXY2_HEAT_HIT to its cell (saturated at 65535),
+ * and the heat of every cell is halved every halfLife frames.
+ * @note Decay is lazy : each cell remembers the epoch (number of half lives) of its last update and is only shifted when it is updated or read,
+ * so the cost of a frame is constant per block, whatever the size of the grid.
+ * @note The heatmap is fed with Pixy2_mergedBlocks when merging is enabled (see pixy2_setBlocMerging), else with Pixy2_blocks.
+ * @param enable    Byte (passed by value) : enable (non-zero) or disable (zero) the heatmap (enabling clears the heatmap)
+ * @param width     Word (passed by value) : width (in pixels) of the frames of the current program
+ * @param height    Word (passed by value) : height (in pixels) of the frames of the current program
+ * @param halfLife  Word (passed by value) : number of frames for the heat of a cell to be halved (at least 1)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setHeatmap (Byte enable, Word width, Word height, Word halfLife);
+
+/**
+ * Get a snapshot of the detection heatmap, decayed to the current frame.
+ * @brief The snapshot can be taken from any thread while pixy2_getBlocks keeps on updating the heatmap :
+ * the copy is made again if a frame was processed in the middle of it (sequence counter), the blocks stream is never stopped.
+ * @param snapshot Word (array of PIXY2_HEAT_ROWS x PIXY2_HEAT_COLS values, passed by address) : heat of each cell, row by row
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the heatmap is disabled).
+ */
+T_pixy2ErrorCode pixy2_getHeatmap (Word *snapshot);
+
+/**
+ * Set (or clear) an entry of the region of interest trigger table.
+ * @brief Triggers are evaluated by the driver on each decoded frame (blocks triggers by pixy2_getBlocks, vectors triggers by pixy2_getMainFeature/pixy2_getAllFeature).
+ * A trigger matches a frame when at least one block (or vector) meets its conditions, it becomes active after pixOnFrames matching frames in a row and inactive after pixOffFrames non matching frames in a row.
+ * Only these changes (edges) call the function attached with pixy2_attachTrigger, so that threads waiting for an event are only woken up when it happens.
+ * @note The table is compiled when set : for each signature, the mask of the triggers it may fire is precomputed, so a block is only compared to the rectangles of its own signature.
+ * The table has a fixed size (PIXY2_MAX_TRIGGERS), so the cost of a frame is bounded.
+ * @note The state of all the triggers is available in Pixy2_triggerState (bit n is set if trigger n is active).
+ * @param number  Byte (passed by value)                        : entry of the table (between 0 and PIXY2_MAX_TRIGGERS - 1)
+ * @param trigger T_pixy2Trigger (structure, passed by address) : trigger definition (NULL or pixType = PIXY2_TRIG_NONE clears the entry)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setTrigger (Byte number, const T_pixy2Trigger *trigger);
+
+/**
+ * Attach the function called on triggers edges.
+ * @brief The function is called from the thread that processes the frame, with the number of the trigger and its new state (1 active, 0 inactive) :
+ * the caller of pixy2_getBlocks for blocks triggers (the thread calling pixy2_processFrame when deferred, see pixy2_setDeferred), the caller of pixy2_get...Feature for vectors triggers.
+ * It should be short, for example setting an EventFlags bit to wake up the subscribing thread.
+ * @note When deferred, the two kinds of triggers may fire from two threads at the same time : the function must be reentrant (EventFlags::set is).
+ * @param function Callback (passed by value) : function to call
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_attachTrigger (Callback<void(Byte, Byte)> function);
+
+/**
+ * Get the oldest record of the driver log.
+ * @brief The driver logs its events (errors, decoded frames...) as compact binary records (event, time stamp, arguments) in a lock-free ring, without any formatting :
+ * logging an event costs a few dozen of instructions instead of the milliseconds of a printf on a serial port, so it doesn't change the timing of the program.
+ * A low priority thread (or a host tool receiving the raw records) reads the records and formats them later (see pixy2_formatLog).
+ * @note Events above PIXY2_LOG_LEVEL are compiled out (no code at all). Define PIXY2_LOG_LEVEL (PIXY2_LOG_OFF to PIXY2_LOG_DEBUG) for the whole program to change it (default is PIXY2_LOG_ERROR).
+ * @note The ring has PIXY2_LOG_SIZE records, it must be read by a single thread. When it is full new records are dropped and counted in Pixy2_logLost.
+ * It is written by the thread that uses the camera and, when deferred, by the thread calling pixy2_processFrame (see pixy2_setDeferred) : each record is written in a short critical section.
+ * @param record T_pixy2LogRecord (structure, passed by address) : copy of the record
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the log is empty).
+ */
+T_pixy2ErrorCode pixy2_readLog (T_pixy2LogRecord *record);
+
+/**
+ * Format a log record as a line of text.
+ * @param record T_pixy2LogRecord (structure, passed by address) : record to format
+ * @param text   char (array, passed by address)                 : text buffer
+ * @param size   int (passed by value)                           : size of the text buffer (the text is truncated if needed)
+ * @return int : length of the (untruncated) text, as snprintf.
+ */
+static int pixy2_formatLog (const T_pixy2LogRecord *record, char *text, int size);
+
+/**
+ * Measure the cost of logging.
+ * @brief Writes count records of the PIXY2_EVT_MEASURE event with the code of the log and measures the time spent.
+ * @note The records are written in a scratch ring (on the stack, PIXY2_LOG_SIZE records) emptied as it goes : the log and Pixy2_logLost are not modified,
+ * and the cost is the one of a record actually stored, whatever count.
+ * @param count Word (passed by value) : number of records to write
+ * @return lWord : mean cost of a record (in nano-seconds).
+ */
+lWord pixy2_measureLog (Word count);
+
+/**
+ * Enable or disable the compact detection log.
+ * @brief When enabled, each blocks frame decoded by pixy2_getBlocks (after all enabled processing) is appended to a sector of PIXY2_REC_SECTOR bytes in a compact binary format.
+ * Two sectors are used alternately : while one is filled by the driver, the other one is written (to a SD card or a flash memory) by a background thread,
+ * using pixy2_getSector and pixy2_releaseSector. A frame of 18 blocks takes at most 440 bytes, a typical frame only a few bytes per block, so the log can follow the full frame rate of the camera.
+ * @note Format of a sector (all integers are unsigned LEB128 varints, signed values are zigzag coded) :
+ * - header : PIXY2_REC_MAGIC, PIXY2_REC_VERSION, sector number (2 bytes, little endian)
+ * - frames : number of blocks + 1, time (micro-seconds, absolute for the first frame of the sector, delta to the previous frame otherwise),
+ *   then for each block its 8 fields (signature, x, y, width, height, angle, index, age) as the difference with the same block of the previous frame of the sector (with 0 if there is none)
+ * - a 0 byte (or the end of the sector) ends the sector, so that each sector can be decoded alone.
+ * @note The sector buffers (2 x PIXY2_REC_SECTOR bytes) are allocated on first enable. When the background thread is late, frames are dropped and counted in Pixy2_recLost.
+ * @note A host side reader (tools/pixy2_rec2csv.c) converts a log to CSV.
+ * @param enable Byte (passed by value) : enable (non-zero) or disable (zero) the log
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the buffers can't be allocated, PIXY2_BUSY if a deferred processing thread is processing a frame : nothing is changed, call it again later).
+ */
+T_pixy2ErrorCode pixy2_setRecorder (Byte enable);
+
+/**
+ * Get the next full sector of the detection log.
+ * @brief To be called by the background thread that writes the log, the sector stays valid (and the driver won't write in it) until pixy2_releaseSector is called.
+ * @param sector Byte (array of PIXY2_REC_SECTOR bytes, passed by address) : pointer to a pointer on the sector
+ * @return T_pixy2ErrorCode : error code (PIXY2_BUSY if no sector is full yet).
+ */
+T_pixy2ErrorCode pixy2_getSector (const Byte **sector);
+
+/**
+ * Release the sector given by pixy2_getSector, once it has been written.
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_releaseSector (void);
+
+/**
+ * Close the sector being filled, so that it can be read with pixy2_getSector even if it is not full (for example before stopping the log).
+ * @return T_pixy2ErrorCode : error code (PIXY2_BUSY if the previous sector has not been released yet, or if a deferred processing thread is filling the sector).
+ */
+T_pixy2ErrorCode pixy2_flushRecorder (void);
+
+/**
+ * Set the time window during which identical requests share the same results.
+ * @brief Several modules of a program (navigation, logging, display...) often ask for the same data : with coalescing enabled, a call to pixy2_getBlocks
+ * (or pixy2_getMainFeature / pixy2_getAllFeature) made while the camera is idle, with the same parameters (and the same filter) as the last decoded request,
+ * and less than window micro-seconds after it, doesn't send anything to the camera : it returns immediately the same error code, and the results
+ * (Pixy2_blocks and all the processed views, or the line features) are left as they are. Only one request goes on the wire, the results are shared by all the requesters.
+ * @note Any other request sent to the camera invalidates the shared results. A window of about one frame (16 ms at 60 FPS) gives one request per camera frame.
+ * @note The number of requests answered this way is counted in Pixy2_coalesced.
+ * @param window lWord (passed by value) : time window (in micro-seconds, 0 disables coalescing - default)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setCoalescing (lWord window);
+
+/**
+ * Enable or disable the publication of blocks frames for other threads.
+ * @brief Each blocks frame decoded by pixy2_getBlocks (after all enabled processing) is copied once into a ring of PIXY2_PUB_SLOTS frames with a sequence number,
+ * so that other threads (logger, display...) can read it without calling the driver, without lock and without any other copy :
+ * a reader gets the last sequence number (pixy2_lastFrame, or the number given to the function attached with pixy2_attachPublisher),
+ * reads the frame in place (pixy2_peekFrame), then checks with pixy2_frameValid that it has not been overwritten meanwhile (in that case the data it read must be discarded).
+ * @note The frame keeps the time of the last received byte (pixRxTime) and of the publication (pixPublishTime) : us_ticker_read() - pixRxTime in the woken reader is the end to end latency.
+ * @note The ring (about 1 KB) is allocated when enabled and freed when disabled (no reader may use it then).
+ * @param enable Byte (passed by value) : enable (non-zero) or disable (zero) the publication
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the ring can't be allocated, PIXY2_BUSY if a deferred processing thread is processing a frame : nothing is changed, call it again later).
+ */
+T_pixy2ErrorCode pixy2_setPublisher (Byte enable);
+
+/**
+ * Attach the function called after each publication.
+ * @brief The function is called from the thread that processes the frame (caller of pixy2_getBlocks, or of pixy2_processFrame when deferred), with the sequence number of the new frame.
+ * It should be short, for example setting an EventFlags bit to wake up the readers.
+ * @param function Callback (passed by value) : function to call
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_attachPublisher (Callback<void(uint32_t)> function);
+
+/**
+ * Get the sequence number of the last published frame.
+ * @return uint32_t : sequence number (0 if no frame has been published yet).
+ */
+uint32_t pixy2_lastFrame (void);
+
+/**
+ * Get a published frame (zero-copy, the frame points into the ring).
+ * @param sequence uint32_t (passed by value) : sequence number of the frame
+ * @return T_pixy2Frame* : pointer on the frame, NULL if it has not been published or has already been overwritten.
+ */
+const T_pixy2Frame* pixy2_peekFrame (uint32_t sequence);
+
+/**
+ * Check that a frame given by pixy2_peekFrame has not been overwritten while it was read.
+ * @param frame T_pixy2Frame (structure, passed by address) : frame given by pixy2_peekFrame
+ * @param sequence uint32_t (passed by value) : sequence number of the frame
+ * @return Byte : 1 if the data read from the frame are valid, 0 if they must be discarded.
+ */
+Byte pixy2_frameValid (const T_pixy2Frame *frame, uint32_t sequence);
+
+/**
+ * Set the time after which a request with no (or no complete) answer is abandoned.
+ * @brief When the timeout is set, a function called while its request is still pending returns PIXY2_TIMEOUT (instead of PIXY2_BUSY) once the time is elapsed,
+ * and the camera is released (state idle), so that the next call sends the request again. Without timeout a lost answer keeps the driver busy forever.
+ * @note All the work of the driver is done by the reception interrupt and by the (non blocking) calls, so a single thread can service many cameras,
+ * by calling in turn the function of each camera : the timeout is checked by these calls (no timer is needed).
+ * @param time lWord (passed by value) : timeout (in micro-seconds, 0 disables the timeout - default)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setTimeout (lWord time);
+
+/**
+ * Enable or disable the statistics of each signature (calibration drift detection).
+ * @brief For each signature (1 to 7, and all the color codes together in slot PIXY2_STATS_CC), the blocks decoded by pixy2_getBlocks update constant memory accumulators :
+ * number of blocks, mean and variance of the position and of the size (exact 64 bits sums of the values and of their squares, one pass : a drift of one pixel is seen even on long windows), and histogram of the angles of color codes.
+ * Every window frames, the accumulators are saved as a snapshot (see pixy2_getStats) and reset.
+ * The first snapshot is the reference : when the mean of a later window moves away from the reference mean by more than threshold tenths of the reference standard deviation
+ * (and by more than one pixel), the bit of the signature is set in Pixy2_statsAlert.
+ * @note The accumulators (about 2.3 KB) are allocated when enabled. Statistics are computed after lens correction, before merging.
+ * @param enable Byte (passed by value) : enable (non-zero, restarts the statistics and the reference) or disable (zero) the statistics
+ * @param window Word (passed by value) : number of frames of a window
+ * @param threshold Word (passed by value) : alert threshold (in tenths of standard deviation, 0 for no alert)
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if window is 0 or if the accumulators can't be allocated, PIXY2_BUSY if a deferred processing thread is processing a frame : nothing is changed, call it again later).
+ */
+T_pixy2ErrorCode pixy2_setStats (Byte enable, Word window, Word threshold);
+
+/**
+ * Get the statistics of a signature over the last complete window.
+ * @param slot Byte (passed by value) : signature (1 to 7) or PIXY2_STATS_CC for color codes
+ * @param stats T_pixy2SigStats (structure, passed by address) : copy of the statistics
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if no window is complete yet).
+ */
+T_pixy2ErrorCode pixy2_getStats (Byte slot, T_pixy2SigStats *stats);
+
+/**
+ * Use the last complete window as the new reference of the statistics (after a recalibration for example), and clear Pixy2_statsAlert.
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if no window is complete yet, PIXY2_BUSY if a deferred processing thread is processing a frame : nothing is changed, call it again later).
+ */
+T_pixy2ErrorCode pixy2_setStatsReference (void);
+
+/**
+ * Enable or disable the normalised views of blocks and line features.
+ * @brief Blocks use the grid of the camera program and line features the PIXY2_LINE_WIDTH x PIXY2_LINE_HEIGHT grid : the normalised views give both in the same
+ * fixed point coordinates (Q15 : 0 is the left / top of the image, PIXY2_NORM_ONE its right / bottom), sizes being scaled the same way.
+ * @note Each frame is converted in one pass when it is decoded (after lens correction), with a scale factor (Q16 inverse of the grid size) computed once per resolution :
+ * @note Pixy2_normBlocks         T_pixy2Bloc (structure array)       : blocks of Pixy2_blocks, coordinates and sizes normalised (Pixy2_numNormBlocks blocks)
+ * @note Pixy2_normVectors        T_pixy2NormVector (structure array) : vectors of Pixy2_vectors (Pixy2_numVectors vectors)
+ * @note Pixy2_normIntersections  T_pixy2NormPoint (structure array)  : position of the intersections of Pixy2_intersections (Pixy2_numIntersections points)
+ * @note Blocks are only normalised when the resolution is known : call pixy2_getResolution once after enabling and after a PIXY2_PROG_CHANGE (it costs a single exchange, then is cached),
+ * else Pixy2_numNormBlocks is 0.
+ * @param enable Byte (passed by value) : enable (non-zero) or disable (zero) the normalised views (the buffers, about 700 bytes, are allocated when enabled)
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the buffers can't be allocated, PIXY2_BUSY if a deferred processing thread is processing a frame : nothing is changed, call it again later).
+ */
+T_pixy2ErrorCode pixy2_setNormalised (Byte enable);
+
+/**
+ * Limit the rate of a class of commands (token bucket).
+ * @brief Commands are sorted in classes (PIXY2_CLASS_DETECT, PIXY2_CLASS_ACTUATOR, PIXY2_CLASS_CONFIG, PIXY2_CLASS_QUERY). A limited class gets rate tokens per second,
+ * up to burst tokens : a request of the class costs one token (PIXY2_RATE_REQUESTS) or one token per byte sent (PIXY2_RATE_BYTES). When there are not enough tokens,
+ * the request is not sent and the function returns PIXY2_THROTTLED (the camera stays free for other requests, call it again later).
+ * Limiting the classes that may be flooded (LED, pixel color...) guarantees the bandwidth of the others (blocks detection).
+ * @note Refused requests are counted by class in the link statistics (see pixy2_getLinkStats). Servo updates of a trajectory are limited as the other actuators.
+ * @param cmdClass Byte (passed by value) : class of commands (PIXY2_CLASS_...)
+ * @param unit Byte (passed by value) : PIXY2_RATE_REQUESTS or PIXY2_RATE_BYTES
+ * @param rate Word (passed by value) : tokens per second (0 removes the limit - default)
+ * @param burst Word (passed by value) : maximum number of tokens (requests or bytes that may be sent at once)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setRateLimit (Byte cmdClass, Byte unit, Word rate, Word burst);
+
+/**
+ * Get the statistics of the link with the camera.
+ * @param stats T_pixy2LinkStats (structure, passed by address) : copy of the statistics
+ * @param reset Byte (passed by value) : reset the statistics after the copy (non-zero) or not (zero)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_getLinkStats (T_pixy2LinkStats *stats, Byte reset);
+
+/**
+ * Set the policy applied when the camera answers with an error reply.
+ * @brief Error replies are decoded according to their length (1, 2 or 4 bytes code), copied in Pixy2_lastError and counted by code in the link statistics (pixCameraErrors).
+ * Then the policy function, if any, chooses what the driver does :
+ * @note PIXY2_POLICY_REPORT  : the error code is returned to the caller (default, and behaviour without policy function)
+ * @note PIXY2_POLICY_RETRY   : PIXY2_BUSY is returned, so the next call (of the polling loop of the caller) sends the request again
+ * @note PIXY2_POLICY_BACKOFF : PIXY2_BUSY is returned and every request is refused with PIXY2_BUSY for backoff micro-seconds (the link is not flooded while the camera is unable to answer)
+ * @note PIXY2_POLICY_REINIT  : the cached version and resolution are dropped (capabilities are reset to PIXY2_CAP_ALL) and the error code is returned
+ * @note The policy function is called by the requesting function (not by the interrupt), it must not call the driver.
+ * @param policy Callback<Byte(const T_pixy2CameraError*)> (passed by value) : policy function, returning PIXY2_POLICY_...
+ * @param backoff lWord (passed by value) : delay of PIXY2_POLICY_BACKOFF (in micro-seconds)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setErrorPolicy (Callback<Byte(const T_pixy2CameraError*)> policy, lWord backoff);
+
+/**
+ * Set the retry policy of a type of failure (bad checksum, unexpected answer type or timeout).
+ * @brief When a request fails, instead of returning the error the driver returns PIXY2_BUSY (and frees the link) while attempts remain :
+ * the next call of the same function sends the request again, once the backoff delay is over (calls made before return PIXY2_BUSY without sending anything).
+ * The delay doubles at each retry (backoff, 2 x backoff, 4 x backoff... up to 16 x backoff). After maxAttempts retries, the error is returned.
+ * @note The request sent again is built from the arguments of the call that sends it : a servo, LED or lamp command retried by a caller that has changed its value
+ * sends the new value only (commands are coalesced, not queued). Each type of request keeps its own retries : calling other functions in between does not abandon them.
+ * @note The servo updates sent by the driver for a trajectory (see pixy2_setTrajectory) are never retried : the next update is sent at the next period.
+ * @note Requests that are not idempotent (pixy2_setNextTurn, pixy2_ReverseVector) may have been executed by the camera even if the answer is lost :
+ * with idempotentOnly, their failures are always returned at once.
+ * @note Retries are counted in the link statistics (pixRetries, and pixRetryFailures for requests that failed after all their attempts).
+ * @param failure Byte (passed by value) : type of failure (PIXY2_FAIL_CHECKSUM, PIXY2_FAIL_TYPE or PIXY2_FAIL_TIMEOUT)
+ * @param maxAttempts Byte (passed by value) : maximum number of retries after the first failure, the request being sent at most maxAttempts + 1 times (0 returns the failure at once - default)
+ * @param backoff lWord (passed by value) : delay before the first retry (in micro-seconds)
+ * @param idempotentOnly Byte (passed by value) : retry only idempotent requests (non-zero) or all requests (zero)
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the type of failure is unknown).
+ */
+T_pixy2ErrorCode pixy2_setRetryPolicy (Byte failure, Byte maxAttempts, lWord backoff, Byte idempotentOnly);
+
+/**
+ * Enable or disable the deferred processing of blocks frames.
+ * @brief By default all the enabled processing (lens correction, ground projection, merging, clustering, tracking, heatmap, triggers, log, publication)
+ * is done by pixy2_getBlocks, in the thread that talks to the camera. With several cameras this thread may spend more time computing than communicating.
+ * When deferred, pixy2_getBlocks only checks, filters and copies the blocks of the frame in a small queue (PIXY2_DEFER_FRAMES frames),
+ * calls the ready function, and returns : the processing is done when pixy2_processFrame is called, usually by a worker thread (for example ready posts
+ * pixy2_processFrame to an EventQueue dispatched by a worker, all the cameras may share the same workers).
+ * @note Frames of a camera are always processed in the order of reception, by one thread at a time. When the workers are late, frames are dropped and counted in Pixy2_deferLost.
+ * @note When deferred, Pixy2_blocks and all the processed views belong to the worker : read them from the worker thread (in the trigger function for example) or through the publisher (see pixy2_setPublisher).
+ * @note Stages and threads when deferred : the thread that talks to the camera (caller of pixy2_getBlocks) receives, checks (checksum, type, retries, timeouts), filters, queues the frame and evaluates the vectors triggers ;
+ * the thread calling pixy2_processFrame runs lens correction, ground projection, merging, clustering, tracking, statistics, heatmap, blocks triggers, recorder and publisher (and their callbacks).
+ * Both threads write the log and update the triggers state, each under a short critical section.
+ * @note The functions that change or free what the processing thread uses (pixy2_setPublisher, pixy2_setStats, pixy2_setStatsReference, pixy2_setNormalised,
+ * pixy2_setRecorder, pixy2_flushRecorder) take the same flag : they return PIXY2_BUSY without changing anything while a frame is being processed.
+ * @note Call it from the thread that talks to the camera. Disabling drops the queued frames (counted in Pixy2_deferLost) and frees the queue.
+ * @param enable Byte (passed by value) : enable (non-zero) or disable (zero) the deferred processing
+ * @param ready Callback (passed by value) : function called by pixy2_getBlocks when a frame is queued
+ * @return T_pixy2ErrorCode : error code (PIXY2_MISC_ERROR if the queue can't be allocated, PIXY2_BUSY if a worker is processing a frame : nothing is changed, call it again later).
+ */
+T_pixy2ErrorCode pixy2_setDeferred (Byte enable, Callback<void()> ready);
+
+/**
+ * Process the queued frames (see pixy2_setDeferred).
+ * @brief May be called by any thread, processes all the queued frames in order.
+ * @return T_pixy2ErrorCode : error code (PIXY2_BUSY if another thread is already processing the frames of this camera : it will process the new ones too).
+ */
+T_pixy2ErrorCode pixy2_processFrame (void);
+
+/**
+ * Set the rate of the servo updates sent for a trajectory (see pixy2_setTrajectory).
+ * @param rate Word (passed by value) : number of updates per second (default is 50)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setServoRate (Word rate);
+
+/**
+ * Move the servos smoothly to a position.
+ * @brief Instead of sending many pixy2_setServos, the application gives the target, the maximum speed and the maximum acceleration :
+ * the driver interpolates a trapezoidal speed profile (both servos move together along a straight line) and sends the servo positions itself, at the rate set by pixy2_setServoRate.
+ * Updates are sent when the link is free, by any call of the driver (pixy2_getBlocks for example) : such a call then returns PIXY2_BUSY once more while the update is acknowledged.
+ * The position is computed when the update is sent, so a late update replaces the stale ones instead of being queued.
+ * @note Calling pixy2_setServos stops the trajectory. A new trajectory starts from the current position of the running one. Pixy2_trajectoryActive is cleared when the target is reached.
+ * @note If the position of the servos is unknown (no pixy2_setServos and no trajectory since the start), the servos first jump to the target.
+ * @param s0 Word (passed by value) : target of servo 0 (between 0 and 511)
+ * @param s1 Word (passed by value) : target of servo 1 (between 0 and 511)
+ * @param speed Word (passed by value) : maximum speed (in position units per second)
+ * @param accel Word (passed by value) : maximum acceleration (in position units per second per second)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setTrajectory (Word s0, Word s1, Word speed, Word accel);
+
+/**
+ * Move the servos smoothly through a list of points (stopping at each point), see pixy2_setTrajectory.
+ * @param points T_pixy2Waypoint (structure array, passed by address) : points of the trajectory (copied)
+ * @param num Byte (passed by value) : number of points (between 1 and PIXY2_MAX_WAYPOINTS)
+ * @param speed Word (passed by value) : maximum speed (in position units per second)
+ * @param accel Word (passed by value) : maximum acceleration (in position units per second per second)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_setWaypoints (const T_pixy2Waypoint *points, Byte num, Word speed, Word accel);
+
+/**
+ * Stop the servo trajectory where it is.
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_stopTrajectory (void);
+
+// Public Global Variables
+/**
+ * @var Byte Pixy2_numBlocks
+ * @brief number of color blocks in Pixy2_blocks
+ */
+Byte                Pixy2_numBlocks;
+
+/**
+ * @var T_pixy2Bloc Pixy2_blocks[]
+ * @brief color blocks detected in the last frame
+ */
+T_pixy2Bloc         *Pixy2_blocks;
+
+/**
+ * @var Byte Pixy2_numVectors
+ * @brief number of vectors in Pixy2_vectors
+ */
+Byte                Pixy2_numVectors;
+
+/**
+ * @var T_pixy2Vector Pixy2_vectors[]
+ * @brief vectors detected in the last frame
+ */
+T_pixy2Vector       *Pixy2_vectors;
+
+/**
+ * @var Byte Pixy2_numIntersections
+ * @brief number of intersections in Pixy2_intersections
+ */
+Byte                Pixy2_numIntersections;
+
+/**
+ * @var T_pixy2Intersection Pixy2_intersections[]
+ * @brief intersections detected in the last frame
+ */
+T_pixy2Intersection *Pixy2_intersections;
+
+/**
+ * @var T_pixy2InterLine Pixy2_interLines[]
+ * @brief lines detected in the last frame
+ */
+T_pixy2InterLine *Pixy2_interLines;
+
+/**
+ * @var Byte Pixy2_numBarcodes
+ * @brief number of barcodes in Pixy2_blocks
+ */
+Byte                Pixy2_numBarcodes;
+
+/**
+ * @var T_pixy2BarCode Pixy2_barcodes[]
+ * @brief bacodes detected in the last frame
+ */
+T_pixy2BarCode      *Pixy2_barcodes;
+
+/**
+ * @var lWord Pixy2_filterCount[]
+ * @brief number of blocks accepted (index 0) and rejected by each predicate (index 1 and over) of the blocks filters (see pixy2_getBlocks with a filter)
+ */
+lWord               Pixy2_filterCount[PIXY2_MAX_FILTER_STAGES + 1];
+
+/**
+ * @var Byte Pixy2_numMergedBlocks
+ * @brief number of color blocks in Pixy2_mergedBlocks
+ */
+Byte                Pixy2_numMergedBlocks;
+
+/**
+ * @var T_pixy2Bloc Pixy2_mergedBlocks[]
+ * @brief color blocks of the last frame after fragments merging (see pixy2_setBlocMerging)
+ */
+T_pixy2Bloc         Pixy2_mergedBlocks[PIXY2_MAX_BLOCS];
+
+/**
+ * @var lWord Pixy2_mergeTime
+ * @brief time (in micro-seconds) spent merging the blocks of the last frame
+ */
+lWord               Pixy2_mergeTime;
+
+/**
+ * @var Byte Pixy2_numClusters
+ * @brief number of clusters in Pixy2_clusters
+ */
+Byte                Pixy2_numClusters;
+
+/**
+ * @var T_pixy2Cluster Pixy2_clusters[]
+ * @brief clusters of color blocks found in the last frame (see pixy2_setClustering)
+ */
+T_pixy2Cluster      Pixy2_clusters[PIXY2_MAX_BLOCS];
+
+/**
+ * @var Byte Pixy2_blocCluster[]
+ * @brief cluster number of each bloc of the last frame (PIXY2_NOISE if none)
+ */
+Byte                Pixy2_blocCluster[PIXY2_MAX_BLOCS];
+
+/**
+ * @var lWord Pixy2_clusterTime
+ * @brief time (in micro-seconds) spent clustering the blocks of the last frame
+ */
+lWord               Pixy2_clusterTime;
+
+/**
+ * @var Byte Pixy2_numTracks
+ * @brief number of tracks in Pixy2_tracks
+ */
+Byte                Pixy2_numTracks;
+
+/**
+ * @var T_pixy2Track Pixy2_tracks[]
+ * @brief objects followed from frame to frame (see pixy2_setTracking)
+ */
+T_pixy2Track        Pixy2_tracks[PIXY2_MAX_TRACKS];
+
+/**
+ * @var Byte Pixy2_blocTrack[]
+ * @brief track id of each bloc of the last frame (PIXY2_NO_TRACK if none)
+ */
+Byte                Pixy2_blocTrack[PIXY2_MAX_BLOCS];
+
+/**
+ * @var lWord Pixy2_trackTime
+ * @brief time (in micro-seconds) spent associating the blocks of the last frame
+ */
+lWord               Pixy2_trackTime;
+
+/**
+ * @var lWord Pixy2_trackWorstTime
+ * @brief worst time (in micro-seconds) spent associating the blocks of a frame since tracking was enabled
+ */
+lWord               Pixy2_trackWorstTime;
+
+/**
+ * @var T_pixy2GroundPoint Pixy2_groundBlocks[]
+ * @brief center of the blocks of the last frame on the ground (see pixy2_setHomography)
+ */
+T_pixy2GroundPoint  Pixy2_groundBlocks[PIXY2_MAX_BLOCS];
+
+/**
+ * @var T_pixy2GroundPoint Pixy2_groundVectors[][2]
+ * @brief tail and head of the vectors of the last frame on the ground (see pixy2_setHomography)
+ */
+T_pixy2GroundPoint  Pixy2_groundVectors[PIXY2_MAX_VECTORS][2];
+
+/**
+ * @var T_pixy2GroundPoint Pixy2_groundIntersections[]
+ * @brief intersections of the last frame on the ground (see pixy2_setHomography)
+ */
+T_pixy2GroundPoint  Pixy2_groundIntersections[PIXY2_MAX_INTERS];
+
+/**
+ * @var lWord Pixy2_groundTime
+ * @brief time (in micro-seconds) spent projecting the last batch of points on the ground
+ */
+lWord               Pixy2_groundTime;
+
+/**
+ * @var lWord Pixy2_groundPoints
+ * @brief number of points of the last batch projected on the ground
+ */
+lWord               Pixy2_groundPoints;
+
+/**
+ * @var Byte Pixy2_triggerState
+ * @brief state of the triggers (bit n is set if trigger n is active, see pixy2_setTrigger)
+ */
+Byte                Pixy2_triggerState;
+
+/**
+ * @var lWord Pixy2_logLost
+ * @brief number of log records dropped because the log ring was full (see pixy2_readLog)
+ */
+lWord               Pixy2_logLost;
+
+/**
+ * @var lWord Pixy2_recLost
+ * @brief number of frames dropped by the detection log because no sector was free (see pixy2_setRecorder)
+ */
+lWord               Pixy2_recLost;
+
+/**
+ * @var lWord Pixy2_coalesced
+ * @brief number of requests answered with the results of an identical previous request (see pixy2_setCoalescing)
+ */
+lWord               Pixy2_coalesced;
+
+/**
+ * @var lWord Pixy2_deferLost
+ * @brief number of frames dropped because the processing thread was late (see pixy2_setDeferred)
+ */
+lWord               Pixy2_deferLost;
+
+/**
+ * @var Byte Pixy2_trajectoryActive
+ * @brief indicate if a servo trajectory is running (see pixy2_setTrajectory)
+ */
+Byte                Pixy2_trajectoryActive;
+
+/**
+ * @var Byte Pixy2_statsAlert
+ * @brief statistics slots whose distribution has shifted from the reference (bit n for slot n, see pixy2_setStats)
+ */
+Byte                Pixy2_statsAlert;
+
+/**
+ * @var Byte Pixy2_numNormBlocks
+ * @brief number of blocks in Pixy2_normBlocks (see pixy2_setNormalised)
+ */
+Byte                Pixy2_numNormBlocks;
+
+/**
+ * @var T_pixy2Bloc Pixy2_normBlocks[]
+ * @brief blocks of the last frame in normalised coordinates (see pixy2_setNormalised)
+ */
+T_pixy2Bloc         *Pixy2_normBlocks;
+
+/**
+ * @var T_pixy2NormVector Pixy2_normVectors[]
+ * @brief vectors of the last frame in normalised coordinates (see pixy2_setNormalised)
+ */
+T_pixy2NormVector   *Pixy2_normVectors;
+
+/**
+ * @var T_pixy2NormPoint Pixy2_normIntersections[]
+ * @brief intersections of the last frame in normalised coordinates (see pixy2_setNormalised)
+ */
+T_pixy2NormPoint    *Pixy2_normIntersections;
+
+/**
+ * @var Byte Pixy2_capabilities
+ * @brief capabilities of the firmware (PIXY2_CAP_..., PIXY2_CAP_ALL until the version is known, see pixy2_getVersion)
+ */
+Byte                Pixy2_capabilities;
+
+/**
+ * @var T_pixy2CameraError Pixy2_lastError
+ * @brief last error reply of the camera (see pixy2_setErrorPolicy)
+ */
+T_pixy2CameraError  Pixy2_lastError;
+
+/**
+ * @var lWord Pixy2_firstAnswerTime
+ * @brief time between the construction of the object and the first complete answer of the camera (in micro-seconds, 0 until then)
+ * @note With Pixy2_firstFrameTime, it splits the startup time (after a brownout for example) between the boot of the camera and the first detection.
+ */
+lWord               Pixy2_firstAnswerTime;
+
+/**
+ * @var lWord Pixy2_firstFrameTime
+ * @brief time between the construction of the object and the reception of the first valid blocks frame (in micro-seconds, 0 until then)
+ */
+lWord               Pixy2_firstFrameTime;
+
+/**
+ * @var lWord Pixy2_allocations
+ * @brief number of dynamic allocations made by the driver (serial port, reception buffer and buffers of the enabled options)
+ */
+lWord               Pixy2_allocations;
+
+/**
+ * @var lWord Pixy2_allocatedBytes
+ * @brief number of bytes of the dynamic allocations counted by Pixy2_allocations
+ */
+lWord               Pixy2_allocatedBytes;
+
+private :
+
+/**************** STATE MACHINE ****************/
+
+typedef enum {idle, messageSent, receivingHeader, receivingData, dataReceived} T_Pixy2State;
+
+// Variables globales Privées
+/**
+ * @var etat (T_Pixy2State) state of the pixy2 cam (idle = No action, messageSent = Query or Set message sent, receivingHeader = Camera is respondig to the query/set, receivingData = Header received, dataReceived = All data has been recovered)
+ * @var Pixy2_buffer (Array of Byte) bytes received from camera
+ * @var wPointer (Byte) write pointer, pointing the next free cell of the array of received bytes
+ * @var hPointer (Byte) header pointer, pointing on the begining of the header field in the array of received bytes
+ * @var dPointer (Byte) data pointer, pointing on the begining of the data field in the array of received bytes
+ * @var dataSize (Byte) number of bytes in the data field
+ * @var frameContainChecksum (Byte) indicate if the received frame contains a checksum
+ */
+T_Pixy2State        etat;
+Byte*               Pixy2_buffer;
+Byte                wPointer, hPointer, dPointer, dataSize;
+Byte                frameContainChecksum;
+
+/**
+ * @var mergeEnable (Byte) indicate if the fragmented blocks must be merged
+ * @var mergeTolerance (Word) maximum gap (in pixels) between two merged boxes
+ */
+Byte                mergeEnable;
+Word                mergeTolerance;
+
+/**
+ * @var clusterEnable (Byte) indicate if the blocks must be clustered
+ * @var clusterEps (Word) neighbourhood radius (in pixels)
+ * @var clusterMinBlocs (Byte) minimum number of neighbours of a core block
+ */
+Byte                clusterEnable;
+Word                clusterEps;
+Byte                clusterMinBlocs;
+
+/**
+ * @var trackEnable (Byte) indicate if the blocks must be associated to tracks
+ * @var trackGate (Word) maximum cost of an association
+ * @var trackMaxMissed (Byte) number of frames a track survives without association
+ * @var trackNextId (Byte) identifier of the next track to be created
+ * @var trackCost (long, array) cost matrix of the assignment of the blocks to the tracks (indexes from 1, kept here to spare the stack)
+ */
+Byte                trackEnable;
+Word                trackGate;
+Byte                trackMaxMissed;
+Byte                trackNextId;
+long                trackCost[PIXY2_MAX_BLOCS + 1][PIXY2_MAX_BLOCS + 1];
+
+/**
+ *  \struct T_pixy2LensGrid
+ *  \brief  Structured type that hold the parameters of the lens correction for one coordinate grid
+ *  \param  cx      (Word)  : X coordinate of the center of the grid
+ *  \param  cy      (Word)  : Y coordinate of the center of the grid
+ *  \param  maxX    (Word)  : highest X coordinate of the grid
+ *  \param  maxY    (Word)  : highest Y coordinate of the grid
+ *  \param  scaleR2 (lWord) : factor (Q16) that converts a square distance to the center into a table position (Q8)
+ */
+typedef struct {
+    Word                cx;
+    Word                cy;
+    Word                maxX;
+    Word                maxY;
+    lWord               scaleR2;
+}T_pixy2LensGrid;
+
+/**
+ * @var lensEnable (Byte) indicate if the coordinates must be corrected
+ * @var lensTable (Word array) correction factors (Q14) for PIXY2_LENS_SIZE evenly spaced values of rd^2 between 0 and 1
+ * @var lensBlocs (T_pixy2LensGrid) correction parameters of the blocks grid
+ * @var lensLine (T_pixy2LensGrid) correction parameters of the line features grid
+ */
+Byte                lensEnable;
+Word                lensTable[PIXY2_LENS_SIZE];
+T_pixy2LensGrid     lensBlocs, lensLine;
+
+/**
+ *  \struct T_pixy2Homography
+ *  \brief  Structured type that hold a cached homography matrix
+ *  \param  enable (Byte)         : indicate if the points of the grid must be projected
+ *  \param  m      (long long array) : matrix coefficients (Q32, row major, normalized so that m8 = 1.0)
+ */
+typedef struct {
+    Byte                enable;
+    long long           m[9];
+}T_pixy2Homography;
+
+/**
+ * @var homography (T_pixy2Homography array) cached matrix of the blocks grid (PIXY2_GRID_BLOCS) and of the line grid (PIXY2_GRID_LINE)
+ */
+T_pixy2Homography   homography[2];
+
+/**
+ * @var heatEnable (Byte) indicate if the heatmap must be updated
+ * @var heatHalfLife (Word) number of frames of a half life
+ * @var heatScaleX (lWord) factor (Q16) converting an X coordinate into a column of the heatmap
+ * @var heatScaleY (lWord) factor (Q16) converting a Y coordinate into a row of the heatmap
+ * @var heatFrame (lWord) number of frames received since the heatmap was enabled
+ * @var heatSeq (uint32_t) sequence counter, odd while a frame is being added to the heatmap (accessed with core_util_atomic_*, cells are ordered around it with __DMB)
+ * @var heatValue (Word array) heat of each cell at its last update
+ * @var heatEpoch (lWord array) epoch (number of half lives) of the last update of each cell
+ */
+Byte                heatEnable;
+Word                heatHalfLife;
+lWord               heatScaleX, heatScaleY;
+volatile lWord      heatFrame;
+volatile uint32_t   heatSeq;
+volatile Word       heatValue[PIXY2_HEAT_ROWS * PIXY2_HEAT_COLS];
+volatile lWord      heatEpoch[PIXY2_HEAT_ROWS * PIXY2_HEAT_COLS];
+
+/**
+ * @var triggers (T_pixy2Trigger array) trigger table
+ * @var trigCount (Byte array) number of consecutive frames that disagree with the state of each trigger
+ * @var trigBySig (Byte array) for each bit of a sigmap, mask of the blocks triggers it may fire
+ * @var trigVectors (Byte) mask of the vectors triggers
+ * @var trigCallback (Callback) function called on edges
+ */
+T_pixy2Trigger      triggers[PIXY2_MAX_TRIGGERS];
+Byte                trigCount[PIXY2_MAX_TRIGGERS];
+Byte                trigBySig[8];
+Byte                trigVectors;
+Callback<void(Byte, Byte)> trigCallback;
+
+/**
+ * @var lazyFeatures (Byte) indicate if the line features are decoded on first access only
+ * @var featurePresent (Byte) ORing of the features present in the last line frame
+ * @var featureDecoded (Byte) ORing of the features of the last line frame already decoded
+ * @var featureOffset (Byte array) position in the reception buffer of the vectors, intersections and barcodes of the last line frame
+ * @var featureLength (Byte array) size (in bytes) of the vectors, intersections and barcodes of the last line frame
+ */
+Byte                lazyFeatures;
+Byte                featurePresent;
+Byte                featureDecoded;
+Byte                featureOffset[3];
+Byte                featureLength[3];
+
+/**
+ * @var logRing (T_pixy2LogRecord array) ring of binary log records
+ * @var logHead (Word) number of records written in the ring since the beginning (only modified by the writer)
+ * @var logTail (Word) number of records read from the ring since the beginning (only modified by the reader)
+ */
+T_pixy2LogRecord    logRing[PIXY2_LOG_SIZE];
+volatile uint16_t   logHead;
+volatile uint16_t   logTail;
+
+/**
+ * @var recEnable (Byte) indicate if blocks frames are written to the detection log
+ * @var recBuffer (Byte array) the two sectors of the detection log (allocated on first enable)
+ * @var recCurrent (Byte) sector being filled by the driver
+ * @var recFull (Byte array) indicate if a sector is full and waits for the background thread
+ * @var recFill (Word) number of bytes used in the sector being filled
+ * @var recSector (Word) number of the sector being filled
+ * @var recTime (lWord) time of the previous frame of the sector
+ * @var recNumPrev (Byte) number of blocks of the previous frame of the sector
+ * @var recPrev (T_pixy2Bloc array) blocks of the previous frame of the sector (reference of the delta coding)
+ */
+Byte                recEnable;
+Byte                *recBuffer;
+Byte                recCurrent;
+volatile uint8_t    recFull[2];
+Word                recFill;
+Word                recSector;
+lWord               recTime;
+Byte                recNumPrev;
+T_pixy2Bloc         recPrev[PIXY2_MAX_BLOCS];
+
+/**
+ * @var coalesceWindow (lWord) time during which results are shared by identical requests (in micro-seconds, 0 = disabled)
+ * @var coalesceValid (Byte) indicate if the last results may be shared
+ * @var coalescePending (lWord) key (type and 2 first bytes of payload) of the last request sent to the camera
+ * @var coalesceKey (lWord) key of the request of the shared results
+ * @var coalesceFilter (function) blocks filter of the request of the shared results
+ * @var coalesceResult (T_pixy2ErrorCode) error code of the request of the shared results
+ * @var coalesceTime (lWord) time when the shared results were decoded
+ */
+lWord               coalesceWindow;
+Byte                coalesceValid;
+lWord               coalescePending;
+lWord               coalesceKey;
+Byte                (*coalesceFilter)(const T_pixy2Bloc*);
+T_pixy2ErrorCode    coalesceResult;
+lWord               coalesceTime;
+
+/**
+ * @var rxTime (lWord) time when the last byte of the last frame was received (in micro-seconds)
+ * @var pubFrames (T_pixy2Frame array) ring of published frames (allocated when the publication is enabled)
+ * @var pubLast (uint32_t) sequence number of the last published frame
+ * @var pubCallback (Callback) function called after each publication
+ */
+volatile lWord      rxTime;
+T_pixy2Frame        *pubFrames;
+volatile uint32_t   pubLast;
+Callback<void(uint32_t)> pubCallback;
+
+/**
+ * @var timeout (lWord) time after which a pending request is abandoned (in micro-seconds, 0 = never)
+ * @var sendTime (lWord) time when the last request was sent
+ * @var linkStats (T_pixy2LinkStats) statistics of the link (partly updated by the reception interrupt)
+ */
+lWord               timeout;
+volatile lWord      sendTime;
+T_pixy2LinkStats    linkStats;
+
+/**
+ * @var deferFrames (T_pixy2Frame array) queue of frames waiting for the processing thread (allocated when the deferred processing is enabled)
+ * @var deferHead (uint8_t) number of frames queued since the beginning (only modified by the thread that talks to the camera)
+ * @var deferTail (uint8_t) number of frames processed since the beginning (only modified by the processing thread)
+ * @var deferBusy (core_util_atomic_flag) set while a thread processes the frames of the camera (or while a function changes what the processing uses, see pixy2_setDeferred)
+ * @var deferReady (Callback) function called when a frame is queued
+ */
+T_pixy2Frame        *deferFrames;
+volatile uint8_t    deferHead;
+volatile uint8_t    deferTail;
+core_util_atomic_flag deferBusy;
+Callback<void()>    deferReady;
+
+/**
+ * @var trajPoints (T_pixy2Waypoint array) points of the servo trajectory
+ * @var trajNum (Byte) number of points of the trajectory
+ * @var trajIndex (Byte) point the servos are moving to
+ * @var trajFrom (Word array) start position of the current segment
+ * @var trajSpeed (Word) maximum speed (in position units per second)
+ * @var trajAccel (Word) maximum acceleration (in position units per second per second)
+ * @var trajStart (lWord) time when the current segment started (in micro-seconds)
+ * @var trajLength (float) length of the current segment (in position units)
+ * @var trajPeak (float) highest speed reached on the current segment
+ * @var trajDuration (float) duration of the current segment (in seconds)
+ * @var servoPeriod (lWord) time between two servo updates (in micro-seconds)
+ * @var servoLast (lWord) time of the last servo update
+ * @var servoPos (Word array) last position sent to the servos (0xFFFF if unknown)
+ * @var streamOwned (Byte) indicate that the pending request is a servo update sent by the driver
+ */
+T_pixy2Waypoint     trajPoints[PIXY2_MAX_WAYPOINTS];
+Byte                trajNum;
+Byte                trajIndex;
+Word                trajFrom[2];
+Word                trajSpeed;
+Word                trajAccel;
+lWord               trajStart;
+float               trajLength;
+float               trajPeak;
+float               trajDuration;
+lWord               servoPeriod;
+lWord               servoLast;
+Word                servoPos[2];
+Byte                streamOwned;
+
+/**
+ *  \struct T_pixy2Bucket
+ *  \brief  token bucket of a command class (tokens are counted in thousandths)
+ */
+typedef struct {
+    Word                rate;
+    Byte                unit;
+    lWord               burst;
+    lWord               tokens;
+    lWord               last;
+}T_pixy2Bucket;
+
+/**
+ * @var buckets (T_pixy2Bucket array) token bucket of each command class
+ */
+T_pixy2Bucket       buckets[PIXY2_CLASSES];
+
+/**
+ *  \struct T_pixy2StatsAcc
+ *  \brief  streaming accumulator of a statistics slot (exact sums of the values and of their squares, in pixels)
+ */
+typedef struct {
+    lWord               count;
+    long long           sum[4];
+    long long           sumSq[4];
+    Word                angles[PIXY2_ANGLE_BINS];
+}T_pixy2StatsAcc;
+
+/**
+ *  \struct T_pixy2StatsState
+ *  \brief  accumulators, last snapshot and reference of all the statistics slots
+ */
+typedef struct {
+    T_pixy2StatsAcc     acc[PIXY2_STATS_SLOTS];
+    T_pixy2SigStats     last[PIXY2_STATS_SLOTS];
+    T_pixy2SigStats     reference[PIXY2_STATS_SLOTS];
+    Word                frames;
+    lWord               windows;
+}T_pixy2StatsState;
+
+/**
+ * @var sigStats (T_pixy2StatsState) statistics of the signatures (allocated when enabled)
+ * @var statsWindow (Word) number of frames of a window
+ * @var statsThreshold (Word) alert threshold (in tenths of standard deviation)
+ */
+T_pixy2StatsState   *sigStats;
+Word                statsWindow;
+Word                statsThreshold;
+
+/**
+ * @var resolution (T_pixy2Resolution) cached resolution of the current program
+ * @var resolutionValid (Byte) indicate if the cached resolution is known
+ * @var normScale (lWord, array of 2 x 2) Q16 scale factors from each grid (PIXY2_GRID_BLOCS / PIXY2_GRID_LINE) to normalised X and Y coordinates
+ * @var normBuffer (Byte array) normalised blocks, vectors and intersections (allocated when enabled)
+ */
+T_pixy2Resolution   resolution;
+Byte                resolutionValid;
+lWord               normScale[2][2];
+Byte                *normBuffer;
+
+/**
+ * @var version (T_pixy2Version) cached version of the camera
+ * @var versionValid (Byte) indicate if the cached version is known
+ */
+T_pixy2Version      version;
+Byte                versionValid;
+
+/**
+ * @var errorPolicy (Callback<Byte(const T_pixy2CameraError*)>) policy applied to the error replies of the camera
+ * @var errorBackoff (lWord) delay of PIXY2_POLICY_BACKOFF (in micro-seconds)
+ * @var errorHold (Byte) indicate if requests are held by PIXY2_POLICY_BACKOFF
+ * @var errorHoldStart (lWord) date of the beginning of the backoff
+ */
+Callback<Byte(const T_pixy2CameraError*)>   errorPolicy;
+lWord               errorBackoff;
+Byte                errorHold;
+lWord               errorHoldStart;
+
+/**
+ *  \struct T_pixy2RetryRule
+ *  \brief  retry policy of a type of failure (see pixy2_setRetryPolicy)
+ */
+typedef struct {
+    Byte                maxAttempts;
+    lWord               backoff;
+    Byte                idempotentOnly;
+}T_pixy2RetryRule;
+
+/**
+ *  \struct T_pixy2RetryState
+ *  \brief  retry state of a type of request
+ *  \param  armed    Byte : indicate if the next request of this type is a retry
+ *  \param  count    Byte : number of retries made after the first failure of the request
+ *  \param  time     lWord : date of the last failure
+ *  \param  delay    lWord : delay before the next retry (in micro-seconds)
+ */
+typedef struct {
+    Byte                armed;
+    Byte                count;
+    lWord               time;
+    lWord               delay;
+}T_pixy2RetryState;
+
+/**
+ * @var retryRules (T_pixy2RetryRule array) retry policy of each type of failure
+ * @var retryState (T_pixy2RetryState array) retry state of each type of request (see pixy2_requestSlot)
+ */
+T_pixy2RetryRule    retryRules[PIXY2_FAILURES];
+T_pixy2RetryState   retryState[PIXY2_REQUESTS];
+
+/**
+ * @var createTime (lWord) date of the construction of the object (origin of Pixy2_firstAnswerTime and Pixy2_firstFrameTime)
+ */
+lWord               createTime;
+
+// Fonctions privées
+
+/**
+ * Queries the firmware and hardware version of Pixy2.
+ * This function is part of the pixy2_getVersion function who treat the reply to this query.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndGetVersion (void);
+
+/**
+ * Queries width and height of the frames used by the current program.
+ * This function is part of the pixy2_getResolution function who treat the reply to this query.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndGetResolution (void);
+
+/**
+ * Sends the relative exposure level of Pixy2's image sensor.
+ * Higher values result in a brighter (more exposed) image.
+ * This function is part of the pixy2_setCameraBrightness function who treat the acknowledge of this frame.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param brightness (Byte - passed by value) : brightness level
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndSetCameraBrightness (Byte brightness);
+
+/**
+ * Sends the servo positions of servos plugged into Pixy2's two RC servo connectors.
+ * This function is part of the pixy2_setServo function who treat the acknowledge of this frame.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param s0 (Word - passed by value) : value between 0 and 511
+ * @param s1 (Word - passed by value) : value between 0 and 511
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndSetServo (Word s0, Word s1);
+
+/**
+ * Sends Pixy2's RGB LED value. The three arguments sets the brightness of the red, green and blue sections of the LED.
+ * It will override Pixy2's own setting of the RGB LED.
+ * This function is part of the pixy2_setLED function who treat the acknowledge of this frame.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param red (Byte - passed by value) : Red component value (between 0 and 255)
+ * @param green (Byte - passed by value) : Green component value (between 0 and 255)
+ * @param blue (Byte - passed by value) : Blue component value (between 0 and 255)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndSetLED (Byte red, Byte green, Byte blue);
+
+/**
+ * Sends command that turns on/off Pixy2's integrated light source.
+ * The upper argument controls the two white LEDs along the top edge of Pixy2's PCB. The lower argument sets the RGB LED, causing it to turn on all three color channels at full brightness, resulting in white light.
+ * It will override Pixy2's own setting of the RGB LED.
+ * This function is part of the pixy2_setLamp function who treat the acknowledge of this frame.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @param upper (Byte - passed by value) : switch on or off the upper lamps (boolean : zero or non-zero)
+ * @param lower (Byte - passed by value) : switch on or off the lower lamp (boolean : zero or non-zero)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndSetLamp (Byte upper, Byte lower);
+
+/**
+ * Queries Pixy2's framerate.
+ * This function is part of the pixy2_getFPS function who treat the reply to this query.
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:general_api
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndGetFPS (void);
+
+/**
+ * Queries all detected color blocks in the most recent frame.
+ * This function is part of the pixy2_getBlocks function who treat the reply to this query.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:color_connected_components
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__ccc_api
+ * @param sigmap (Byte - passed by value) : signature filtering
+ * @param maxBloc (Byte - passed by value) : maximum number of blocks to return
+ * @return T_pixy2ErrorCode : error code.
+ * @note There are 7 different signatures definition (sig1 to sig7). Color codes are made of a combination of signature and can be filtered as well.
+ * @note Filtering is based on ORing codes : 1 for sig1, 2 for sig2, 4 for sig3, 8 for sig4, 16 for sig5, 32 for sig6, 64 sor sig7 and 128 for color code.
+ * @note So sigmap = 255 means accept all and sigmap = 0 means reject all. For example filtering to get only sig1 and sig5 means using sigmap = 17 (16 + 1).
+ */
+T_pixy2ErrorCode pixy2_sndGetBlocks (Byte sigmap, Byte maxBloc);
+
+/**
+ * Queries the latest features of Line tracking in the most recent frame.
+ * The results are returned in the variables vectors, intersections, and barcodes, respectively.
+ * This function is part of the pixy2_getMainFeature or pixy2_getAllFeature function who treat the reply to this query.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param type (Byte - passed by value) : select between Main or All features (0 for main feature only, 1 for all features)
+ * @param feature (Byte - passed by value) : feature filtering
+ * @return T_pixy2ErrorCode : error code (if negative) or ORing of feature detected (if positive).
+ * @note There are 3 possible features (vectors, intersections and barcodes).
+ * @note Filtering or detected feature are based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
+ * @note So for filtering : 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode means using feature = 5 (1 + 4).
+ * @note So for return value : 1 means only vector(s) detected, 2 means only intersection(s) detected, 3 vector(s) and intersection(s) detected and so on.
+ */
+T_pixy2ErrorCode pixy2_sndGetLineFeature (Byte type, Byte feature);
+
+/**
+ * Sets various modes in the line tracking algorithm.
+ * This function is part of the pixy2_setMode function who treat the acknowledge of this frame.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param mode (Byte - passed by value) : ORing of required feature
+ * @return T_pixy2ErrorCode : error code.
+ * @note There are 3 possible features :
+ * @note * LINE_MODE_TURN_DELAYED : Normally, the line tracking algorithm will choose the straightest path (branch) when encountering an intersection. Setting LINE_MODE_TURN_DELAYED will prevent the line tracking algorithm from choosing the path automatically. This is useful if your program doesn't know beforehand which path it wants to take at the next intersection.
+ * @note * LINE_MODE_MANUAL_SELECT_VECTOR : Normally, the line tracking algorithm will choose what it thinks is the best Vector line automatically. Setting LINE_MODE_MANUAL_SELECT_VECTOR will prevent the line tracking algorithm from choosing the Vector automatically. Instead, your program will need to set the Vector by calling setVector().
+ * @note * LINE_MODE_WHITE_LINE : Normally, the line tracking algorithm will try to find dark lines on a light background (black lines). Setting LINE_MODE_WHITE_LINE will instruct the line tracking algorithm to look for light lines on a dark background (white lines).
+ */
+T_pixy2ErrorCode pixy2_sndSetMode (Byte mode);
+
+/**
+ * Tells the line tracking algorithm which path it should take at the next intersection.
+ * This function is part of the pixy2_setNextTurn function who treat the acknowledge of this frame.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param angle (sWord - passed by value) : angle closest to the next turn (in degree, between -180 and 180)
+ * @return T_pixy2ErrorCode : error code.
+ * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
+ * @note setNextTurn() will remember the turn angle you give it, and execute it at the next intersection. The line tracking algorithm will then go back to the default turn angle for subsequent intersections.
+ * @note Upon encountering an intersection, the line tracking algorithm will find the path in the intersection that matches the turn angle most closely.
+ */
+T_pixy2ErrorCode pixy2_sndSetNextTurn (Word angle);
+
+/**
+ * Tells the line tracking algorithm which path to choose by default upon encountering an intersection.
+ * This function is part of the pixy2_setDefaultTurn function who treat the acknowledge of this frame.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param angle (sWord - passed by value) : angle closest to the default turn (in degree, between -180 and 180)
+ * @return T_pixy2ErrorCode : error code.
+ * @note Turn angles are specified in degrees, with 0 being straight ahead, left being 90 and right being -90, although any valid angle value can be used.
+ * @note The line tracking algorithm will find the path in the intersection that matches the default turn angle most closely.
+ * @note A call to setNextTurn() will supercede the default turn angle for the next intersection.
+ */
+T_pixy2ErrorCode pixy2_sndSetDefaultTurn (Word angle);
+
+/**
+ * Tells witch vector the tracking algorithm must choose as default route upon encountering an intersection.
+ * This function is part of the pixy2_setVector function who treat the acknowledge of this frame.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param vectorindex (Byte - passed by value) : index of the vector to follow
+ * @return T_pixy2ErrorCode : error code.
+ * @note If the LINE_MODE_MANUAL_SELECT_VECTOR mode bit is set, the line tracking algorithm will no longer choose the Vector automatically. Instead, setVector() will set the Vector by providing the index of the line.
+ */
+T_pixy2ErrorCode pixy2_sndSetVector (Byte vectorIndex);
+
+/**
+ * Reverse the head and the tail of vectors
+ * This function is part of the pixy2_reverseVector function who treat the acknowledge of this frame.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @return T_pixy2ErrorCode : error code.
+ * @note The Vector has a direction. It normally points up, from the bottom of the camera frame to the top of the camera frame for a forward-moving robot. Calling reverseVector() will invert the vector. This will typically cause your robot to back-up and change directions.
+ */
+T_pixy2ErrorCode pixy2_sndReverseVector (void);
+
+/**
+ * Queries the average RGB components of a square of 5x5 pixels centered on the given pixel coordinate
+ * This function is part of the pixy2_getRGB function who treat the reply to this query.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:video_api
+ * @param x (Word - passed by value) : X coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 315) 
+ * @param y (Word - passed by value) : Y coordinate of the center of de 5x5 pixels square (in pixel, between 0 and 207)
+ * @param saturate (Byte - passed by value) : scale the 3 RGB components so that the highest one of the 3 RGB components is set to 255 (boolean : zero or non-zero) 
+ * @param pixel (T_pixy2Pixel - passed by reference) : RGB pixel. 
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_sndGetRGB (Word x, Word y, Byte saturate);
+
+/**
+ * Gets all the latest features of Line tracking in the most recent frame.
+ * The results are returned in the variables vectors, intersections, and barcodes, respectively.
+ * @note General description : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:line_tracking
+ * @note Frame Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:porting_guide
+ * @note Function Documentation : https://docs.pixycam.com/wiki/doku.php?id=wiki:v2:pixy2_full_api#plugin_include__wiki__v2__line_api
+ * @param feature (Byte - passed by value) : feature filtering
+ * @return T_pixy2ErrorCode : error code.
+ * @note There are 3 possible features (vectors, intersections and barcodes).
+ * @note Filtering is based on ORing codes : 1 for vectors, 2 for intersections, 4 for barcodes.
+ * @note So 7 = accept all, 0 = reject all. For example filtering to get only vectors and barcode means using feature = 5 (1 + 4).
+ */
+T_pixy2ErrorCode pixy2_getFeatures (void);
+
+/**
+ * Gets all detected color blocks in the most recent frame and keeps only those accepted by a filter.
+ * This function is the body of both pixy2_getBlocks functions.
+ * @param sigmap (Byte - passed by value) : signature filtering
+ * @param maxBloc (Byte - passed by value) : maximum number of blocks to return
+ * @param reject (function pointer) : filter, returns 0 if the block is accepted or the number of the predicate that rejected it (NULL for no filter)
+ * @return T_pixy2ErrorCode : error code.
+ */
+T_pixy2ErrorCode pixy2_getFilteredBlocks (Byte sigmap, Byte maxBloc, Byte (*reject)(const T_pixy2Bloc*));
+
+void pixy2_getByte ();
+T_pixy2ErrorCode pixy2_validateChecksum (Byte* tab);
+
+/**
+ * Post-processing of a blocks frame, called by pixy2_getBlocks once Pixy2_blocks and Pixy2_numBlocks are mapped.
+ * Runs the enabled processing stages in order.
+ */
+void pixy2_processBlocks (void);
+
+/**
+ * Merges the blocks of same signature whose boxes overlap (or touch within mergeTolerance) into Pixy2_mergedBlocks.
+ */
+void pixy2_mergeBlocks (void);
+
+/**
+ * Groups the blocks (merged ones if merging is enabled) with a grid accelerated DBSCAN into Pixy2_clusters and Pixy2_blocCluster.
+ */
+void pixy2_clusterBlocks (void);
+
+/**
+ * Associates the blocks (merged ones if merging is enabled) to Pixy2_tracks, creates and deletes tracks.
+ */
+void pixy2_trackBlocks (void);
+
+/**
+ * Writes a record in the log ring (use PIXY2_LOG so that the call is compiled out above PIXY2_LOG_LEVEL).
+ * @param level (Byte) : level of the event
+ * @param event (Byte) : event
+ * @param a0 (Word) : first argument
+ * @param a1 (Word) : second argument
+ * @param a2 (Word) : third argument
+ */
+void pixy2_log (Byte level, Byte event, Word a0, Word a1, Word a2);
+
+/**
+ * Writes a record in a ring (single writer).
+ * @param ring (T_pixy2LogRecord array) : ring of PIXY2_LOG_SIZE records
+ * @param head (uint16_t, passed by address) : number of records written in the ring
+ * @param tail (uint16_t, passed by address) : number of records read from the ring
+ * @param level (Byte) : level of the event
+ * @param event (Byte) : event
+ * @param a0 (Word) : first argument
+ * @param a1 (Word) : second argument
+ * @param a2 (Word) : third argument
+ * @return Byte : 1 if the record is written, 0 if the ring is full.
+ */
+static Byte pixy2_logWrite (T_pixy2LogRecord *ring, volatile uint16_t *head, const volatile uint16_t *tail, Byte level, Byte event, Word a0, Word a1, Word a2);
+
+/**
+ * Answers a request with the shared results of the last identical request, if they are still valid (see pixy2_setCoalescing).
+ * @param key (lWord) : type and 2 first bytes of payload of the request
+ * @param filter (function) : blocks filter of the request (NULL if none)
+ * @param cr (T_pixy2ErrorCode, passed by address) : error code of the shared results
+ * @return Byte : 1 if the request is answered, 0 if it must be sent to the camera.
+ */
+Byte pixy2_coalesce (lWord key, Byte (*filter)(const T_pixy2Bloc*), T_pixy2ErrorCode *cr);
+
+/**
+ * Records the results of the last request as shareable.
+ * @param filter (function) : blocks filter of the request (NULL if none)
+ * @param cr (T_pixy2ErrorCode) : error code of the request
+ */
+void pixy2_coalesceStore (Byte (*filter)(const T_pixy2Bloc*), T_pixy2ErrorCode cr);
+
+/**
+ * Publishes the blocks of the last frame for other threads.
+ */
+void pixy2_publishBlocks (void);
+
+/**
+ * Answer of a function called while its request is pending (state other than idle or dataReceived).
+ * Abandons the request when the timeout is elapsed.
+ * @return T_pixy2ErrorCode : PIXY2_BUSY, or PIXY2_TIMEOUT if the request has been abandoned.
+ */
+T_pixy2ErrorCode pixy2_checkPending (void);
+
+/**
+ * Queues the blocks of a frame for the processing thread.
+ * @param blocks (T_pixy2Bloc array, passed by address) : blocks of the frame
+ * @param num (int) : number of blocks
+ */
+void pixy2_deferBlocks (const T_pixy2Bloc *blocks, int num);
+
+/**
+ * Computes the speed profile of the current segment of the servo trajectory.
+ */
+void pixy2_segmentTime (void);
+
+/**
+ * Computes the position of the servos on the trajectory (moves to the next segments when needed).
+ * @param now (lWord) : time (in micro-seconds)
+ * @param s0 (Word, passed by address) : position of servo 0
+ * @param s1 (Word, passed by address) : position of servo 1
+ */
+void pixy2_trajectoryPoint (lWord now, Word *s0, Word *s1);
+
+/**
+ * Sends the servo updates of the trajectory when the link is free and consumes their acknowledge (called at the beginning of every request).
+ * @return Byte : 1 if the link is used by a servo update (the request must wait), 0 otherwise.
+ */
+Byte pixy2_streamServos (void);
+
+/**
+ * Updates the statistics of the signatures with the blocks of the last frame.
+ */
+void pixy2_updateStats (void);
+
+/**
+ * Compares the statistics of a window with the reference.
+ * @param window (T_pixy2SigStats, passed by address) : statistics of the window
+ * @param reference (T_pixy2SigStats, passed by address) : reference statistics
+ * @return Byte : 1 if the distribution has shifted.
+ */
+Byte pixy2_statsShift (const T_pixy2SigStats *window, const T_pixy2SigStats *reference);
+
+/**
+ * Decodes the result code of an acknowledge or error reply, according to its length.
+ * Error replies are counted and logged, invalidate the cached resolution on PIXY2_PROG_CHANGE, and go through the error policy.
+ * @return T_pixy2ErrorCode : result code of the reply (PIXY2_BUSY if the policy retries or backs off).
+ */
+T_pixy2ErrorCode pixy2_readResult (void);
+
+/**
+ * Caches the resolution of the current program and its normalisation factors.
+ * @param res (T_pixy2Resolution, passed by address) : resolution received from the camera
+ */
+void pixy2_setResolution (const T_pixy2Resolution *res);
+
+/**
+ * Normalises a coordinate or a size.
+ * @param v (Word) : coordinate or size (in pixels of the grid)
+ * @param size (Word) : size of the grid (values are clamped to it)
+ * @param scale (lWord) : Q16 scale factor of the grid
+ * @return Word : normalised value (Q15).
+ */
+static Word pixy2_normalise (Word v, Word size, lWord scale);
+
+/**
+ * Converts the blocks of the last frame to normalised coordinates.
+ */
+void pixy2_normaliseBlocks (void);
+
+/**
+ * Converts the decoded line features to normalised coordinates.
+ * @param features (Byte) : kinds of features to convert (PIXY2_VECTOR, PIXY2_INTERSECTION)
+ */
+void pixy2_normaliseFeatures (Byte features);
+
+/**
+ * Gives the command class of a request.
+ * @param type (Byte) : type of the request
+ * @return Byte : command class (PIXY2_CLASS_...).
+ */
+static Byte pixy2_commandClass (Byte type);
+
+/**
+ * Gives the capability needed by a request.
+ * @param type (Byte) : type of the request
+ * @return Byte : capability (PIXY2_CAP_...).
+ */
+static Byte pixy2_commandCapability (Byte type);
+
+/**
+ * Caches the version of the camera and deduces the capabilities of its firmware.
+ * @param ver (T_pixy2Version, passed by address) : version received from the camera
+ */
+void pixy2_setVersion (const T_pixy2Version *ver);
+
+/**
+ * Indicates if a request may be sent again without side effect.
+ * @param type (Byte) : type of the request
+ * @return Byte : 1 if the request is idempotent.
+ */
+static Byte pixy2_idempotent (Byte type);
+
+/**
+ * Checks a received reply (checksum and type). A reply that cannot be decoded is handled here and frees the link :
+ * bad checksum or unexpected type (retry policy, link statistics and log) or error frame of the camera (see pixy2_readResult).
+ * @param type (Byte) : type of the expected reply
+ * @param cr (T_pixy2ErrorCode*) : error code to return when the reply is not decoded
+ * @return Byte : 1 if the reply is valid and of the expected type (the caller decodes it), else 0.
+ */
+Byte pixy2_acceptReply (Byte type, T_pixy2ErrorCode *cr);
+
+/**
+ * Gives the rank of a type of request in the retry states.
+ * @param type (Byte) : type of the request
+ * @return Byte : rank of the request (0 to PIXY2_REQUESTS - 1).
+ */
+static Byte pixy2_requestSlot (Byte type);
+
+/**
+ * Applies the retry policy to a failed request and frees the link.
+ * The servo updates of a trajectory are not retried.
+ * @param failure (Byte) : type of failure (PIXY2_FAIL_...)
+ * @param code (T_pixy2ErrorCode) : error code of the failure
+ * @return T_pixy2ErrorCode : PIXY2_BUSY if the request will be sent again, else the error code.
+ */
+T_pixy2ErrorCode pixy2_retry (Byte failure, T_pixy2ErrorCode code);
+
+/**
+ * Allocates a buffer of the driver and counts it (see Pixy2_allocations).
+ * @param size (size_t) : size of the buffer (in bytes)
+ * @return void* : pointer to the buffer (NULL if the allocation failed).
+ */
+void* pixy2_alloc (size_t size);
+
+/**
+ * Takes the tokens needed by a request from the bucket of its class.
+ * @param cmdClass (Byte) : command class
+ * @param size (int) : size of the request (in bytes)
+ * @return Byte : 1 if the request may be sent, 0 if it is throttled.
+ */
+Byte pixy2_takeToken (Byte cmdClass, int size);
+
+/**
+ * Appends the blocks of the last frame to the detection log.
+ */
+void pixy2_recordBlocks (void);
+
+/**
+ * Starts a new sector of the detection log in the current buffer.
+ */
+void pixy2_startSector (void);
+
+/**
+ * Publishes the sector being filled for the background thread and starts the other one.
+ * @return T_pixy2ErrorCode : error code (PIXY2_BUSY if the other sector has not been released yet).
+ */
+T_pixy2ErrorCode pixy2_closeSector (void);
+
+/**
+ * Decoding of the features of a line frame, called by pixy2_getFeatures (and by the access functions in lazy mode) once the features are indexed.
+ * Maps the requested features that are not yet decoded and runs the enabled processing stages on them.
+ * @param features (Byte) : ORing of the features to decode (PIXY2_VECTOR, PIXY2_INTERSECTION, PIXY2_BARCODE)
+ */
+void pixy2_processFeatures (Byte features);
+
+/**
+ * Prepares the lens correction of a grid.
+ * @param grid (T_pixy2LensGrid - passed by reference) : grid to prepare
+ * @param width (Word) : width of the grid
+ * @param height (Word) : height of the grid
+ */
+static void pixy2_setLensGrid (T_pixy2LensGrid *grid, Word width, Word height);
+
+/**
+ * Corrects (in place) a point of a grid with the lens correction table.
+ * @param grid (T_pixy2LensGrid - passed by reference) : grid of the point
+ * @param x (Word - passed by reference) : X coordinate of the point
+ * @param y (Word - passed by reference) : Y coordinate of the point
+ */
+void pixy2_correctPoint (const T_pixy2LensGrid *grid, Word *x, Word *y);
+
+/**
+ * Corrects (in place) the coordinates of the blocks of the last frame.
+ */
+void pixy2_correctBlocks (void);
+
+/**
+ * Corrects (in place) the coordinates of the vectors, intersections and barcodes of the last frame.
+ * @param features (Byte) : ORing of the features to correct
+ */
+void pixy2_correctFeatures (Byte features);
+
+/**
+ * Projects a batch of points on the ground (in place).
+ * @param h (T_pixy2Homography - passed by reference) : cached matrix of the grid of the points
+ * @param points (T_pixy2GroundPoint array) : pixel coordinates of the points, replaced by their ground coordinates
+ * @param n (int) : number of points
+ */
+static void pixy2_transformPoints (const T_pixy2Homography *h, T_pixy2GroundPoint *points, int n);
+
+/**
+ * Projects the centers of the blocks of the last frame on the ground.
+ */
+void pixy2_groundBlocks (void);
+
+/**
+ * Projects the vector ends and intersections of the last frame on the ground.
+ * @param features (Byte) : ORing of the features to project
+ */
+void pixy2_groundFeatures (Byte features);
+
+/**
+ * Adds the centers of the blocks of the last frame to the heatmap.
+ */
+void pixy2_updateHeatmap (void);
+
+/**
+ * Evaluates the blocks triggers on the blocks of the last frame.
+ */
+void pixy2_evalBlocTriggers (void);
+
+/**
+ * Evaluates the vectors triggers on the vectors of the last frame.
+ */
+void pixy2_evalVectorTriggers (void);
+
+/**
+ * Updates the hysteresis of a set of triggers and signals the edges.
+ * @param mask (Byte) : triggers evaluated on this frame
+ * @param matched (Byte) : triggers matched on this frame
+ */
+void pixy2_updateTriggers (Byte mask, Byte matched);
+
+/**
+ * Sorts an array of indexes by increasing key (heap sort : O(n log n), no recursion, no extra memory).
+ * @param index (Byte array) : indexes to sort (in place)
+ * @param key (lWord array) : sort key of each indexed element
+ * @param n (Byte) : number of indexes
+ */
+static void pixy2_sortIndex (Byte *index, const lWord *key, Byte n);
+
+
+/**************** UTILS ****************/
+
+/**
+ *  \union  T_Word
+ *  \brief  Structured type to switch from word to bytes
+ *  \param  mot (Word)   : 16 bits word
+ *  \param  octet (Byte) : 2 bytes that overlap mot (byte access)
+ */
+typedef union {
+    Word    mot;
+    Byte    octet[2];
+}T_Word;
+
+/**
+ *  \union T_lWord
+ *  \brief  Structured type to switch from lword to word or bytes
+ *  \param  motLong (lWord) : 32 bits word
+ *  \param  mot (Word)      : 2 x 16 bits words that overlap motLong (word access)
+ *  \param  octet (Byte)    : 4 bytes that overlap motLong (byte access)
+ */
+typedef union {
+    lWord   motLong;
+    Word    mot[2];
+    Byte    octet[4];
+}T_lWord;
+
+
+/**************** HEADERS ****************/
+
+/**
+ *  \struct T_pixy2Header
+ *  \brief  Structured type that match pixy2 header without checksum (send message)
+ *  \param  pixSync   (Word) : 16 bits synchro word - could be 0xc1ae (PIXY2_SYNC) or 0xc1af (PIXY2_CSSYNC)
+ *  \param  pixType   (Byte) : 8 bits message type identifier
+ *  \param  pixLength (Byte) : 8 bits message payload length (payload doesn't include checksum) 
+ */
+typedef struct {
+    Word                pixSync;
+    Byte                pixType;
+    Byte                pixLength;
+}T_pixy2Header;
+
+/**
+ *  \struct T_pixy2SendFrame
+ *  \brief  Structured type that match frame definition for all kind of message to send to a pixy2 
+ *  \param  header (T_pixy2Header) : 4 bytes classical header starting with PIXY2_SYNC
+ *  \param  data   (Byte)          : 5 bytes payload (to match all usage, not all byte must be used)
+ */
+typedef struct {
+    T_pixy2Header       header;
+    Byte                data[5];
+}T_pixy2SendFrame;
+
+/**
+ *  \union  T_pixy2SendBuffer
+ *  \brief  Structured type to switch between structured type T_pixy2sendFrame and bytes 
+ *  \param  frame (T_pixy2SendFrame) : classical frame (header + payload) starting with PIXY2_SYNC
+ *  \param  data  (Byte)             : 9 bytes that overlap frame (byte access)
+ */
+typedef union {
+    T_pixy2SendFrame    frame;
+    Byte                data[9];
+}T_pixy2SendBuffer;
+
+/**
+ *  \struct T_pixy2RcvHeader
+ *  \brief  Structured type that match pixy2 header with checksum (received message)
+ *  \param  pixSync   (Word) : 16 bits synchro word - could be 0xc1ae (PIXY2_SYNC) or 0xc1af (PIXY2_CSSYNC)
+ *  \param  pixType   (Byte) : 8 bits message type identifier
+ *  \param  pixLength (Byte) : 8 bits message payload length (payload doesn't include checksum) 
+ *  \param  pixSync   (Word) : 16 bits checksum (sum of all bytes of the payload)
+ */
+typedef struct {
+    Word                pixSync;
+    Byte                pixType;
+    Byte                pixLength;
+    Word                pixChecksum;
+}T_pixy2RcvHeader;
+
+/**
+ * Sends a frame to the camera (common part of all the pixy2_snd... functions).
+ * @param msg (T_pixy2SendBuffer, passed by address) : frame to send
+ * @note The frame is not sent (and the link stays idle) when the firmware lacks the capability needed by the request (PIXY2_UNSUPPORTED, see pixy2_getVersion),
+ * while the error policy backs off (PIXY2_BUSY, see pixy2_setErrorPolicy), while a retry waits for its delay (PIXY2_BUSY, see pixy2_setRetryPolicy)
+ * or when the command class is over its rate limit (PIXY2_THROTTLED, see pixy2_setRateLimit).
+ * @param dataSize (int) : size of the payload
+ * @return T_pixy2ErrorCode : error code (PIXY2_OK, PIXY2_UNSUPPORTED, PIXY2_BUSY, PIXY2_THROTTLED or PIXY2_MISC_ERROR on a short write).
+ */
+T_pixy2ErrorCode pixy2_sndFrame (T_pixy2SendBuffer *msg, int dataSize);
+
+protected :
+
+UnbufferedSerial*  _Pixy2;
+
+// POUR DEBUG //
+T_Pixy2State getEtat();
+void affDataSize();
+
+}; // End Class
+
+/**************** BLOCKS FILTERS ****************/
+
+/**
+ * \struct PIXY2_FilterChain
+ * \brief Compile time chain of block predicates used by PIXY2::pixy2_getBlocks<Filter>.
+ * A predicate is a structure with a static function "bool accept (const PIXY2::T_pixy2Bloc *bloc)", the chain calls them in order (all calls are inlined).
+ * reject returns 0 if the block is accepted by all predicates, else the number (from 1) of the first predicate that rejected it.
+ */
+template <class... Stages> struct PIXY2_FilterChain;
+
+template <> struct PIXY2_FilterChain<> {
+    static const int size = 0;
+    static PIXY2::Byte reject (const PIXY2::T_pixy2Bloc *) {return 0;}
+};
+
+template <class First, class... Others> struct PIXY2_FilterChain<First, Others...> {
+    static const int size = 1 + sizeof... (Others);
+    static PIXY2::Byte reject (const PIXY2::T_pixy2Bloc *bloc) {
+        PIXY2::Byte stage;
+        if (!First::accept (bloc)) return 1;
+        stage = PIXY2_FilterChain<Others...>::reject (bloc);
+        return stage ? stage + 1 : 0;
+    }
+};
+
+/**
+ * \struct PIXY2_FilterArea
+ * \brief Block predicate : accept blocks whose area (width x height, in square pixels) is between MinArea and MaxArea (included)
+ */
+template <PIXY2::lWord MinArea, PIXY2::lWord MaxArea> struct PIXY2_FilterArea {
+    static bool accept (const PIXY2::T_pixy2Bloc *bloc) {
+        PIXY2::lWord area = (PIXY2::lWord) bloc->pixWidth * bloc->pixHeight;
+        return (area >= MinArea) && (area <= MaxArea);
+    }
+};
+
+/**
+ * \struct PIXY2_FilterRect
+ * \brief Block predicate : accept blocks whose center is inside the rectangle (Left, Top) - (Right, Bottom) (included, in pixels)
+ */
+template <PIXY2::Word Left, PIXY2::Word Top, PIXY2::Word Right, PIXY2::Word Bottom> struct PIXY2_FilterRect {
+    static bool accept (const PIXY2::T_pixy2Bloc *bloc) {
+        return (bloc->pixX >= Left) && (bloc->pixX <= Right) && (bloc->pixY >= Top) && (bloc->pixY <= Bottom);
+    }
+};
+
+/**
+ * \struct PIXY2_FilterAngle
+ * \brief Block predicate : accept color codes whose angle is between MinAngle and MaxAngle (included, in degree), and all the blocks that are not color codes (signature 1 to 7)
+ */
+template <int MinAngle, int MaxAngle> struct PIXY2_FilterAngle {
+    static bool accept (const PIXY2::T_pixy2Bloc *bloc) {
+        if (bloc->pixSignature <= 7) return true;
+        return (bloc->pixAngle >= MinAngle) && (bloc->pixAngle <= MaxAngle);
+    }
+};
+
+/**
+ * \struct PIXY2_FilterAge
+ * \brief Block predicate : accept blocks tracked by the camera for at least MinAge frames (removes flickering detections)
+ */
+template <PIXY2::Byte MinAge> struct PIXY2_FilterAge {
+    static bool accept (const PIXY2::T_pixy2Bloc *bloc) {
+        return bloc->pixAge >= MinAge;
+    }
+};
+
+template <class Filter>
+PIXY2::T_pixy2ErrorCode PIXY2::pixy2_getBlocks (Byte sigmap, Byte maxBloc){
+    static_assert (Filter::size <= PIXY2_MAX_FILTER_STAGES, "too many predicates in the blocks filter");
+    return pixy2_getFilteredBlocks (sigmap, maxBloc, &Filter::reject);
+}
+
+#endif        
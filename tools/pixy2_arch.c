@@ -0,0 +1,166 @@
+/**
+ * @file pixy2_arch.c
+ * @brief host side tool for pixy2 detection archives (see pixy2_archive.h)
+ * @note build : cc -O2 -o pixy2_arch pixy2_arch.c pixy2_archive.c
+ * @note usage :
+ * - pixy2_rec2csv log.bin | pixy2_arch import archive : appends the frames of a detection log (CSV from pixy2_rec2csv) to an archive
+ * - pixy2_arch query archive start end [signature]     : prints the blocks of a signature (all if omitted) between two times (micro-seconds)
+ * - pixy2_arch bench archive gigabytes                 : builds a synthetic archive of the given size, then measures seeks and scans
+ */
+
+#define _FILE_OFFSET_BITS 64
+#include "pixy2_archive.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now (void)
+{
+    struct timespec t;
+
+    clock_gettime (CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static int import (const char *name)
+{
+    pixy2_archWriter    writer;
+    pixy2_archBloc      blocs[PIXY2_ARCH_MAX_BLOCS];
+    char                line[256];
+    unsigned long       time, lastTime = 0, wrap = 0;
+    uint64_t            frameTime = 0;
+    int                 sector, num, bloc, v[8], count = 0, pending = 0;
+    long                frames = 0;
+
+    if (pixy2_archCreate (&writer, name) < 0) {
+        perror (name);
+        return 1;
+    }
+    if (fgets (line, sizeof (line), stdin) == NULL) return 0;                       // Entête CSV
+    while (fgets (line, sizeof (line), stdin) != NULL) {
+        memset (v, 0, sizeof (v));
+        bloc = 0;
+        if (sscanf (line, "%d,%lu,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d", &sector, &time, &num, &bloc, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]) < 3) continue;
+        if (pending && (bloc == 0)) {                                               // Nouvelle trame : on écrit la précédente
+            if (pixy2_archAppend (&writer, frameTime, blocs, count) == 0) frames++;
+            pending = 0;
+        }
+        if (!pending) {
+            if (time < lastTime) wrap++;                                            // Le temps de la carte (32 bits) a rebouclé
+            lastTime = time;
+            frameTime = ((uint64_t) wrap << 32) + time;
+            count = 0;
+            pending = 1;
+        }
+        if (num > 0 && count < PIXY2_ARCH_MAX_BLOCS) {
+            blocs[count].signature = v[0];
+            blocs[count].x = v[1];
+            blocs[count].y = v[2];
+            blocs[count].width = v[3];
+            blocs[count].height = v[4];
+            blocs[count].angle = v[5];
+            blocs[count].index = v[6];
+            blocs[count].age = v[7];
+            blocs[count].reserved = 0;
+            count++;
+        }
+    }
+    if (pending && pixy2_archAppend (&writer, frameTime, blocs, count) == 0) frames++;
+    pixy2_archClose (&writer);
+    fprintf (stderr, "%ld frames imported\n", frames);
+    return 0;
+}
+
+static int query (const char *name, uint64_t start, uint64_t end, int signature)
+{
+    pixy2_archive           archive;
+    pixy2_archCursor        cursor;
+    const pixy2_archFrame   *frame;
+    const pixy2_archBloc    *bloc;
+
+    if (pixy2_archOpen (&archive, name) < 0) {
+        perror (name);
+        return 1;
+    }
+    printf ("time_us,signature,x,y,width,height,angle,index,age\n");
+    pixy2_archQuery (&archive, &cursor, start, end, signature);
+    while (pixy2_archNext (&archive, &cursor, &frame, &bloc))
+        printf ("%llu,%u,%u,%u,%u,%u,%d,%u,%u\n", (unsigned long long) frame->time, bloc->signature, bloc->x, bloc->y, bloc->width, bloc->height, bloc->angle, bloc->index, bloc->age);
+    pixy2_archRelease (&archive);
+    return 0;
+}
+
+static int bench (const char *name, double gigabytes)
+{
+    pixy2_archWriter        writer;
+    pixy2_archive           archive;
+    pixy2_archCursor        cursor;
+    const pixy2_archFrame   *frame;
+    const pixy2_archBloc    *bloc;
+    pixy2_archBloc          blocs[PIXY2_ARCH_MAX_BLOCS];
+    uint64_t                size = 0, target = (uint64_t) (gigabytes * 1e9), time = 0, found = 0, sum = 0, frames;
+    double                  t0, t1;
+    int                     i, n;
+    long                    seeks = 1000000;
+
+    remove (name);                                                                  // Archive synthétique : 60 trames/s, 1 à 18 blocs de signatures 1 à 7
+    if (pixy2_archCreate (&writer, name) < 0) {
+        perror (name);
+        return 1;
+    }
+    srand (1);
+    t0 = now();
+    while (size < target) {
+        n = 1 + rand() % PIXY2_ARCH_MAX_BLOCS;
+        for (i = 0; i < n; i++) {
+            memset (&blocs[i], 0, sizeof (blocs[i]));
+            blocs[i].signature = 1 + rand() % 7;
+            blocs[i].x = rand() % 316;
+            blocs[i].y = rand() % 208;
+            blocs[i].width = 1 + rand() % 50;
+            blocs[i].height = 1 + rand() % 50;
+        }
+        if (pixy2_archAppend (&writer, time, blocs, n) < 0) {
+            perror ("append");
+            return 1;
+        }
+        size += sizeof (pixy2_archFrame) + n * sizeof (pixy2_archBloc) + sizeof (pixy2_archIndex);
+        time += 16667;
+    }
+    pixy2_archClose (&writer);
+    t1 = now();
+    printf ("write : %.2f GB in %.1f s (%.0f MB/s)\n", size / 1e9, t1 - t0, size / 1e6 / (t1 - t0));
+
+    if (pixy2_archOpen (&archive, name) < 0) {
+        perror (name);
+        return 1;
+    }
+    frames = archive.numFrames;
+    t0 = now();
+    for (i = 0; i < seeks; i++) sum += pixy2_archSeek (&archive, ((uint64_t) rand() * 7919) % time);
+    t1 = now();
+    printf ("seek  : %llu frames, %.2f us per seek (check %llu)\n", (unsigned long long) frames, (t1 - t0) * 1e6 / seeks, (unsigned long long) (sum % 1000));
+
+    t0 = now();
+    pixy2_archQuery (&archive, &cursor, 0, UINT64_MAX, 3);
+    while (pixy2_archNext (&archive, &cursor, &frame, &bloc)) {
+        found++;
+        sum += bloc->x;
+    }
+    t1 = now();
+    printf ("scan  : %llu blocks of signature 3 in %.2f s (%.0f MB/s)\n", (unsigned long long) found, t1 - t0, archive.dataSize / 1e6 / (t1 - t0));
+    pixy2_archRelease (&archive);
+    return 0;
+}
+
+int main (int argc, char *argv[])
+{
+    if (argc == 3 && strcmp (argv[1], "import") == 0) return import (argv[2]);
+    if ((argc == 5 || argc == 6) && strcmp (argv[1], "query") == 0) return query (argv[2], strtoull (argv[3], NULL, 0), strtoull (argv[4], NULL, 0), (argc == 6) ? atoi (argv[5]) : 0);
+    if (argc == 4 && strcmp (argv[1], "bench") == 0) return bench (argv[2], atof (argv[3]));
+    fprintf (stderr, "usage : %s import archive < log.csv\n", argv[0]);
+    fprintf (stderr, "        %s query archive start end [signature]\n", argv[0]);
+    fprintf (stderr, "        %s bench archive gigabytes\n", argv[0]);
+    return 1;
+}
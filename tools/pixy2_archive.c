@@ -0,0 +1,230 @@
+/**
+ * @file pixy2_archive.c
+ * @brief host side (POSIX) archive of pixy2 detection frames (see pixy2_archive.h)
+ */
+
+#define _FILE_OFFSET_BITS 64
+#include "pixy2_archive.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    uint32_t            magic;
+    uint32_t            version;
+    uint32_t            blocSize;
+    uint32_t            reserved;
+}pixy2_archHeader;
+
+static int writeAll (int fd, const void *buffer, size_t size)
+{
+    const uint8_t   *p = (const uint8_t*) buffer;
+    ssize_t         n;
+
+    while (size > 0) {
+        n = write (fd, p, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        size -= n;
+    }
+    return 0;
+}
+
+static char* indexName (const char *name)
+{
+    char    *path = (char*) malloc (strlen (name) + 5);
+
+    if (path != NULL) sprintf (path, "%s.idx", name);
+    return path;
+}
+
+int pixy2_archCreate (pixy2_archWriter *writer, const char *name)
+{
+    pixy2_archHeader    header = {PIXY2_ARCH_MAGIC, PIXY2_ARCH_VERSION, sizeof (pixy2_archBloc), 0};
+    pixy2_archIndex     last;
+    pixy2_archFrame     frame;
+    struct stat         st;
+    char                *path = indexName (name);
+    off_t               end;
+
+    if (path == NULL) return -1;
+    memset (writer, 0, sizeof (*writer));
+    writer->data = open (name, O_RDWR | O_CREAT, 0644);
+    writer->index = open (path, O_RDWR | O_CREAT, 0644);
+    free (path);
+    if (writer->data < 0 || writer->index < 0 || fstat (writer->index, &st) < 0) goto error;
+    end = st.st_size - st.st_size % sizeof (pixy2_archIndex);                       // Entrée incomplète (arrêt brutal) : on l'écrase
+    if (end == 0) {                                                                 // Nouvelle archive
+        if (ftruncate (writer->data, 0) < 0 || writeAll (writer->data, &header, sizeof (header)) < 0) goto error;
+        writer->size = sizeof (header);
+    } else {                                                                        // Archive existante : on reprend après la dernière trame indexée
+        if (pread (writer->index, &last, sizeof (last), end - sizeof (last)) != sizeof (last)) goto error;
+        if (pread (writer->data, &header, sizeof (header), 0) != sizeof (header) || header.magic != PIXY2_ARCH_MAGIC) {
+            errno = EINVAL;
+            goto error;
+        }
+        if (pread (writer->data, &frame, sizeof (frame), last.offset) != sizeof (frame)) goto error;
+        writer->size = last.offset + sizeof (frame) + frame.numBlocks * sizeof (pixy2_archBloc);
+        writer->lastTime = last.time;
+        writer->numFrames = end / sizeof (pixy2_archIndex);
+        if (ftruncate (writer->data, writer->size) < 0 || ftruncate (writer->index, end) < 0) goto error;  // Trame non indexée (arrêt brutal) : on l'abandonne
+    }
+    if (lseek (writer->data, writer->size, SEEK_SET) < 0 || lseek (writer->index, end, SEEK_SET) < 0) goto error;
+    return 0;
+
+error:
+    if (writer->data >= 0) close (writer->data);
+    if (writer->index >= 0) close (writer->index);
+    return -1;
+}
+
+int pixy2_archAppend (pixy2_archWriter *writer, uint64_t time, const pixy2_archBloc *blocs, int numBlocks)
+{
+    pixy2_archFrame     frame;
+    pixy2_archIndex     entry;
+
+    if ((numBlocks < 0) || (numBlocks > PIXY2_ARCH_MAX_BLOCS) || ((writer->numFrames > 0) && (time < writer->lastTime))) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset (&frame, 0, sizeof (frame));
+    frame.time = time;
+    frame.numBlocks = numBlocks;
+    entry.time = time;
+    entry.offset = writer->size;
+    if (writeAll (writer->data, &frame, sizeof (frame)) < 0) return -1;             // La trame d'abord, l'index ensuite : un index valide désigne toujours une trame complète
+    if (writeAll (writer->data, blocs, numBlocks * sizeof (pixy2_archBloc)) < 0) return -1;
+    if (writeAll (writer->index, &entry, sizeof (entry)) < 0) return -1;
+    writer->size += sizeof (frame) + numBlocks * sizeof (pixy2_archBloc);
+    writer->lastTime = time;
+    writer->numFrames++;
+    return 0;
+}
+
+int pixy2_archClose (pixy2_archWriter *writer)
+{
+    int     cr = 0;
+
+    if (close (writer->data) < 0) cr = -1;
+    if (close (writer->index) < 0) cr = -1;
+    return cr;
+}
+
+static const void* mapFile (const char *path, size_t *size)
+{
+    struct stat st;
+    void        *map;
+    int         fd = open (path, O_RDONLY);
+
+    if (fd < 0) return NULL;
+    if (fstat (fd, &st) < 0 || st.st_size == 0) {
+        close (fd);
+        return NULL;
+    }
+    map = mmap (NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);                                                                     // La projection reste valide
+    if (map == MAP_FAILED) return NULL;
+    *size = st.st_size;
+    return map;
+}
+
+int pixy2_archOpen (pixy2_archive *archive, const char *name)
+{
+    const pixy2_archHeader  *header;
+    const pixy2_archFrame   *frame;
+    char                    *path = indexName (name);
+
+    memset (archive, 0, sizeof (*archive));
+    if (path == NULL) return -1;
+    archive->data = (const uint8_t*) mapFile (name, &archive->dataSize);
+    archive->index = (const pixy2_archIndex*) mapFile (path, &archive->indexSize);
+    free (path);
+    if (archive->data == NULL || archive->dataSize < sizeof (pixy2_archHeader)) goto error;
+    header = (const pixy2_archHeader*) archive->data;
+    if (header->magic != PIXY2_ARCH_MAGIC || header->version != PIXY2_ARCH_VERSION || header->blocSize != sizeof (pixy2_archBloc)) goto error;
+    if (archive->index == NULL) return 0;                                           // Archive vide
+    madvise ((void*) archive->index, archive->indexSize, MADV_WILLNEED);            // L'index est parcouru par dichotomie
+    archive->numFrames = archive->indexSize / sizeof (pixy2_archIndex);
+    while (archive->numFrames > 0) {                                                // On ignore une dernière trame tronquée
+        frame = pixy2_archFrameAt (archive, archive->numFrames - 1);
+        if (frame != NULL) break;
+        archive->numFrames--;
+    }
+    return 0;
+
+error:
+    pixy2_archRelease (archive);
+    errno = EINVAL;
+    return -1;
+}
+
+void pixy2_archRelease (pixy2_archive *archive)
+{
+    if (archive->data != NULL) munmap ((void*) archive->data, archive->dataSize);
+    if (archive->index != NULL) munmap ((void*) archive->index, archive->indexSize);
+    memset (archive, 0, sizeof (*archive));
+}
+
+const pixy2_archFrame* pixy2_archFrameAt (const pixy2_archive *archive, uint64_t frame)
+{
+    uint64_t                offset;
+    const pixy2_archFrame   *f;
+
+    if (frame >= archive->indexSize / sizeof (pixy2_archIndex)) return NULL;
+    offset = archive->index[frame].offset;
+    if (offset + sizeof (pixy2_archFrame) > archive->dataSize) return NULL;
+    f = (const pixy2_archFrame*) (archive->data + offset);
+    if (offset + sizeof (pixy2_archFrame) + f->numBlocks * sizeof (pixy2_archBloc) > archive->dataSize) return NULL;
+    return f;
+}
+
+uint64_t pixy2_archSeek (const pixy2_archive *archive, uint64_t time)
+{
+    uint64_t    low = 0, high = archive->numFrames, middle;
+
+    while (low < high) {                                                            // Premier index dont le temps est >= time
+        middle = low + (high - low) / 2;
+        if (archive->index[middle].time < time) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+void pixy2_archQuery (const pixy2_archive *archive, pixy2_archCursor *cursor, uint64_t startTime, uint64_t endTime, int signature)
+{
+    cursor->frame = pixy2_archSeek (archive, startTime);
+    cursor->bloc = 0;
+    cursor->endTime = endTime;
+    cursor->signature = signature;
+}
+
+int pixy2_archNext (const pixy2_archive *archive, pixy2_archCursor *cursor, const pixy2_archFrame **frame, const pixy2_archBloc **bloc)
+{
+    const pixy2_archFrame   *f;
+    const pixy2_archBloc    *b;
+
+    while (cursor->frame < archive->numFrames) {
+        f = pixy2_archFrameAt (archive, cursor->frame);
+        if (f->time > cursor->endTime) break;
+        b = (const pixy2_archBloc*) (f + 1);
+        while (cursor->bloc < f->numBlocks) {
+            if ((cursor->signature == 0) || (b[cursor->bloc].signature == cursor->signature)) {
+                *frame = f;
+                *bloc = &b[cursor->bloc++];
+                return 1;
+            }
+            cursor->bloc++;
+        }
+        cursor->frame++;
+        cursor->bloc = 0;
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file pixy2_archive.h
+ * @brief host side (POSIX) archive of pixy2 detection frames : append-only data file, memory-mapped for queries, with a time index
+ * @note An archive "name" is made of two files : name (frames) and name.idx (time index, one entry per frame).
+ * Frames are written with pixy2_archAppend (times must not decrease), and read without any copy through the mapping of the files :
+ * pixy2_archSeek finds the first frame at or after a time in O(log n), pixy2_archNext iterates over the blocks of a signature in a time range.
+ * @note Both files are only appended to, so an archive can be queried while it is being written (reopen it to see the new frames),
+ * and a crash can only leave a truncated last frame, which is ignored.
+ */
+
+#ifndef _PIXY2_ARCHIVE_
+#define _PIXY2_ARCHIVE_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PIXY2_ARCH_MAGIC    0x41325850  // "PX2A"
+#define PIXY2_ARCH_VERSION  1
+#define PIXY2_ARCH_MAX_BLOCS 18         // PIXY2_MAX_BLOCS
+
+/**
+ *  \struct pixy2_archBloc
+ *  \brief  block of a frame, as stored in the archive (same fields as T_pixy2Bloc, 16 bytes)
+ */
+typedef struct {
+    uint16_t            signature;
+    uint16_t            x;
+    uint16_t            y;
+    uint16_t            width;
+    uint16_t            height;
+    int16_t             angle;
+    uint8_t             index;
+    uint8_t             age;
+    uint16_t            reserved;
+}pixy2_archBloc;
+
+/**
+ *  \struct pixy2_archFrame
+ *  \brief  header of a frame, as stored in the archive (16 bytes), followed by numBlocks pixy2_archBloc
+ */
+typedef struct {
+    uint64_t            time;           // micro-seconds
+    uint16_t            numBlocks;
+    uint16_t            reserved[3];
+}pixy2_archFrame;
+
+/**
+ *  \struct pixy2_archIndex
+ *  \brief  entry of the time index (one per frame)
+ */
+typedef struct {
+    uint64_t            time;
+    uint64_t            offset;         // position of the frame in the data file
+}pixy2_archIndex;
+
+/**
+ *  \struct pixy2_archWriter
+ *  \brief  archive opened for appending
+ */
+typedef struct {
+    int                 data;
+    int                 index;
+    uint64_t            size;           // size of the data file
+    uint64_t            lastTime;
+    uint64_t            numFrames;
+}pixy2_archWriter;
+
+/**
+ *  \struct pixy2_archive
+ *  \brief  archive opened (mapped) for queries
+ */
+typedef struct {
+    const uint8_t       *data;
+    size_t              dataSize;
+    const pixy2_archIndex *index;
+    size_t              indexSize;
+    uint64_t            numFrames;
+}pixy2_archive;
+
+/**
+ *  \struct pixy2_archCursor
+ *  \brief  position of an iteration (see pixy2_archNext)
+ */
+typedef struct {
+    uint64_t            frame;          // number of the current frame
+    int                 bloc;           // next block of the current frame
+    uint64_t            endTime;        // iteration stops after this time
+    int                 signature;      // signature of the blocks (0 for all the blocks)
+}pixy2_archCursor;
+
+/**
+ * Open (or create) an archive for appending frames.
+ * @return 0 on success, -1 on error (errno is set).
+ */
+int pixy2_archCreate (pixy2_archWriter *writer, const char *name);
+
+/**
+ * Append a frame to the archive.
+ * @return 0 on success, -1 on error (time going backward, too many blocks or write error).
+ */
+int pixy2_archAppend (pixy2_archWriter *writer, uint64_t time, const pixy2_archBloc *blocs, int numBlocks);
+
+/**
+ * Close an archive opened for appending.
+ */
+int pixy2_archClose (pixy2_archWriter *writer);
+
+/**
+ * Map an archive for queries.
+ * @return 0 on success, -1 on error.
+ */
+int pixy2_archOpen (pixy2_archive *archive, const char *name);
+
+/**
+ * Unmap an archive.
+ */
+void pixy2_archRelease (pixy2_archive *archive);
+
+/**
+ * Get a frame by its number (zero-copy, the frame points into the mapping).
+ */
+const pixy2_archFrame* pixy2_archFrameAt (const pixy2_archive *archive, uint64_t frame);
+
+/**
+ * Find the first frame at or after a time (binary search in the index).
+ * @return number of the frame (numFrames if there is none).
+ */
+uint64_t pixy2_archSeek (const pixy2_archive *archive, uint64_t time);
+
+/**
+ * Start an iteration over the blocks of a signature (0 for all) between two times (included).
+ */
+void pixy2_archQuery (const pixy2_archive *archive, pixy2_archCursor *cursor, uint64_t startTime, uint64_t endTime, int signature);
+
+/**
+ * Get the next block of the iteration (zero-copy, frame and bloc point into the mapping).
+ * @return 1 if a block is returned, 0 at the end of the iteration.
+ */
+int pixy2_archNext (const pixy2_archive *archive, pixy2_archCursor *cursor, const pixy2_archFrame **frame, const pixy2_archBloc **bloc);
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file pixy2_rec2csv.c
+ * @brief host side reader of the pixy2 compact detection log (see PIXY2::pixy2_setRecorder), converts a log file (sequence of sectors) to CSV
+ * @note build : cc -O2 -o pixy2_rec2csv pixy2_rec2csv.c
+ * @note usage : pixy2_rec2csv log.bin > log.csv
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REC_SECTOR      512         // Doit correspondre à PIXY2_REC_SECTOR
+#define REC_MAGIC       0xB2        // Doit correspondre à PIXY2_REC_MAGIC
+#define REC_VERSION     1           // Doit correspondre à PIXY2_REC_VERSION
+#define REC_MAX_BLOCS   18          // Doit correspondre à PIXY2_MAX_BLOCS
+#define REC_FIELDS      8           // signature, x, y, width, height, angle, index, age
+
+static const unsigned char  *end;   // Fin du secteur en cours de lecture
+
+static int getVarint (const unsigned char **p, unsigned long *value)
+{
+    int     shift = 0;
+
+    *value = 0;
+    while (*p < end && shift < 35) {
+        *value |= (unsigned long) (**p & 0x7F) << shift;
+        if ((*(*p)++ & 0x80) == 0) return 1;
+        shift += 7;
+    }
+    return 0;                                                                       // Varint tronqué
+}
+
+static long unZigzag (unsigned long value)
+{
+    return (value & 1) ? -(long) ((value + 1) >> 1) : (long) (value >> 1);
+}
+
+int main (int argc, char *argv[])
+{
+    FILE                *in;
+    unsigned char       sector[REC_SECTOR];
+    const unsigned char *p;
+    unsigned long       value, time = 0;
+    long                prev[REC_MAX_BLOCS][REC_FIELDS], cur[REC_MAX_BLOCS][REC_FIELDS];
+    int                 numPrev, num, i, f, number, first, expected = -1;
+    long                sectors = 0, frames = 0, errors = 0;
+
+    if (argc != 2) {
+        fprintf (stderr, "usage : %s log.bin > log.csv\n", argv[0]);
+        return 1;
+    }
+    in = fopen (argv[1], "rb");
+    if (in == NULL) {
+        perror (argv[1]);
+        return 1;
+    }
+    printf ("sector,time_us,blocks,bloc,signature,x,y,width,height,angle,index,age\n");
+    while (fread (sector, 1, REC_SECTOR, in) == REC_SECTOR) {
+        if (sector[0] != REC_MAGIC || sector[1] != REC_VERSION) {                   // Secteur vide ou d'un autre format : on l'ignore
+            errors++;
+            continue;
+        }
+        number = sector[2] | (sector[3] << 8);
+        if (expected >= 0 && number != expected) fprintf (stderr, "sector %d : %d sectors missing\n", number, (number - expected) & 0xFFFF);
+        expected = (number + 1) & 0xFFFF;
+        sectors++;
+        p = &sector[4];
+        end = &sector[REC_SECTOR];
+        numPrev = 0;                                                                // Chaque secteur est décodable seul
+        first = 1;
+        while (p < end && *p != 0) {                                                // 0 : fin du secteur
+            if (!getVarint (&p, &value) || value - 1 > REC_MAX_BLOCS) break;
+            num = (int) value - 1;
+            if (!getVarint (&p, &value)) break;
+            time = first ? value : time + value;                                    // Temps absolu pour la première trame du secteur
+            first = 0;
+            for (i = 0; i < num; i++) {
+                for (f = 0; f < REC_FIELDS; f++) {
+                    if (!getVarint (&p, &value)) break;
+                    cur[i][f] = unZigzag (value) + ((i < numPrev) ? prev[i][f] : 0);
+                }
+                if (f < REC_FIELDS) break;
+            }
+            if (i < num) {                                                          // Trame tronquée
+                errors++;
+                break;
+            }
+            if (num == 0) printf ("%d,%lu,0,,,,,,,,,\n", number, time);
+            for (i = 0; i < num; i++) {
+                printf ("%d,%lu,%d,%d", number, time, num, i);
+                for (f = 0; f < REC_FIELDS; f++) printf (",%ld", cur[i][f]);
+                printf ("\n");
+            }
+            memcpy (prev, cur, sizeof (cur));
+            numPrev = num;
+            frames++;
+        }
+    }
+    fclose (in);
+    fprintf (stderr, "%ld sectors, %ld frames, %ld errors\n", sectors, frames, errors);
+    return 0;
+}